@@ -19,7 +19,7 @@ Variant BBNode::get_value(Node *p_scene_root, const Ref<Blackboard> &p_blackboar
 	if (get_value_source() == SAVED_VALUE) {
 		val = get_saved_value();
 	} else {
-		val = p_blackboard->get_var(get_variable(), p_default);
+		val = p_blackboard->get_var_by_handle(_get_variable_handle(p_blackboard), p_default);
 	}
 
 	if (val.get_type() == Variant::NODE_PATH) {
@@ -23,6 +23,7 @@ protected:
 public:
 	virtual Variant::Type get_type() const override { return Variant::NODE_PATH; }
 	virtual Variant get_value(Node *p_scene_root, const Ref<Blackboard> &p_blackboard, const Variant &p_default = Variant()) override;
+	virtual bool is_thread_safe() const override { return false; }
 };
 
 #endif // BB_NODE_H
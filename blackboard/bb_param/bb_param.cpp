@@ -39,6 +39,7 @@ void BBParam::set_saved_value(Variant p_value) {
 
 void BBParam::set_variable(const StringName &p_variable) {
 	variable = p_variable;
+	handle_blackboard_id = 0;
 	_update_name();
 	emit_changed();
 }
@@ -78,8 +79,9 @@ Variant BBParam::get_value(Node *p_scene_root, const Ref<Blackboard> &p_blackboa
 		}
 		return saved_value;
 	} else {
-		ERR_FAIL_COND_V_MSG(!p_blackboard->has_var(variable), p_default, vformat("BBParam: Blackboard variable \"%s\" doesn't exist.", variable));
-		return p_blackboard->get_var(variable, p_default);
+		const int handle = _get_variable_handle(p_blackboard);
+		ERR_FAIL_COND_V_MSG(!p_blackboard->has_var_by_handle(handle), p_default, vformat("BBParam: Blackboard variable \"%s\" doesn't exist.", variable));
+		return p_blackboard->get_var_by_handle(handle, p_default);
 	}
 }
 
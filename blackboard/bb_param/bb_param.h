@@ -39,6 +39,10 @@ private:
 	Variant saved_value;
 	StringName variable;
 
+	// Handle of the variable in the most recently used blackboard.
+	uint64_t handle_blackboard_id = 0;
+	int variable_handle = -1;
+
 	_FORCE_INLINE_ void _update_name() {
 		set_name((value_source == SAVED_VALUE) ? String(saved_value) : LimboUtility::get_singleton()->decorate_var(variable));
 	}
@@ -48,6 +52,15 @@ protected:
 
 	void _assign_default_value();
 
+	_FORCE_INLINE_ int _get_variable_handle(const Ref<Blackboard> &p_blackboard) {
+		const uint64_t id = (uint64_t)p_blackboard->get_instance_id();
+		if (unlikely(id != handle_blackboard_id)) {
+			variable_handle = p_blackboard->get_var_handle(variable);
+			handle_blackboard_id = id;
+		}
+		return variable_handle;
+	}
+
 	void _get_property_list(List<PropertyInfo> *p_list) const;
 
 public:
@@ -70,6 +83,10 @@ public:
 	virtual Variant::Type get_variable_expected_type() const { return get_type(); }
 	virtual Variant get_value(Node *p_scene_root, const Ref<Blackboard> &p_blackboard, const Variant &p_default = Variant());
 
+	// False if get_value() may access the scene tree, which is only allowed on the main thread.
+	// Tasks that report being thread-safe must check their params, see BTTask::_is_thread_safe().
+	virtual bool is_thread_safe() const { return true; }
+
 	BBParam();
 };
 
@@ -0,0 +1,62 @@
+/**
+ * bb_read_tracker.cpp
+ * =============================================================================
+ * Copyright (c) 2023-present Serhii Snitsaruk and the LimboAI contributors.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#include "bb_read_tracker.h"
+
+thread_local BBReadTracker *BBReadTracker::current = nullptr;
+
+void BBReadTracker::_record(const BBVariable &p_var, uint64_t p_version, const Blackboard *p_scope, const Blackboard *p_owner, uint64_t p_resolved_at) {
+	for (BBReadTracker *tracker = current; tracker; tracker = tracker->prev) {
+		tracker->reads.push_back({ p_var, p_version, p_owner, p_resolved_at, tracker->_add_scope(p_scope) });
+	}
+}
+
+uint32_t BBReadTracker::_add_scope(const Blackboard *p_scope) {
+	// * Consecutive reads usually go through the same blackboard.
+	if (!scopes.is_empty() && scopes[scopes.size() - 1].ptr() == p_scope) {
+		return scopes.size() - 1;
+	}
+	scopes.push_back(Ref<Blackboard>(const_cast<Blackboard *>(p_scope)));
+	return scopes.size() - 1;
+}
+
+void BBReadTracker::begin() {
+	ERR_FAIL_COND_MSG(current == this, "BBReadTracker: Already active.");
+	prev = current;
+	current = this;
+}
+
+void BBReadTracker::end() {
+	ERR_FAIL_COND_MSG(current != this, "BBReadTracker: Not the innermost active tracker.");
+	current = prev;
+	prev = nullptr;
+}
+
+void BBReadTracker::forward() const {
+	if (current == nullptr) {
+		return;
+	}
+	for (const Read &read : reads) {
+		_record(read.var, read.version, scopes[read.scope].ptr(), read.owner, read.resolved_at);
+	}
+}
+
+bool BBReadTracker::has_changes() const {
+	for (const Read &read : reads) {
+		if (read.version == UNTRACKED || (read.owner && read.var.get_version() != read.version)) {
+			return true;
+		}
+		if (!scopes[read.scope]->_is_lookup_valid(read.owner, read.resolved_at)) {
+			return true;
+		}
+	}
+	return false;
+}
@@ -0,0 +1,81 @@
+/**
+ * bb_read_tracker.h
+ * =============================================================================
+ * Copyright (c) 2023-present Serhii Snitsaruk and the LimboAI contributors.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+#ifndef BB_READ_TRACKER_H
+#define BB_READ_TRACKER_H
+
+#include "bb_variable.h"
+#include "blackboard.h"
+
+#ifdef LIMBOAI_MODULE
+#include "core/templates/local_vector.h"
+#endif // LIMBOAI_MODULE
+
+#ifdef LIMBOAI_GDEXTENSION
+#include <godot_cpp/templates/local_vector.hpp>
+using namespace godot;
+#endif // LIMBOAI_GDEXTENSION
+
+// Records blackboard variables read on the current thread between begin() and end(),
+// along with their versions, so that the reader can later tell whether any of its inputs changed.
+// A read also depends on the scopes walked to find the variable: if any of them adds, removes or
+// replaces a variable afterwards (e.g. shadows it), the read is reported as changed, like a stale
+// Blackboard slot. Reads of missing variables are tracked the same way.
+// Trackers nest: a read is recorded by every tracker active on the thread.
+// Reads of property-bound variables can't be tracked and are always reported as changed.
+class BBReadTracker {
+private:
+	struct Read {
+		BBVariable var;
+		uint64_t version = 0;
+		const Blackboard *owner = nullptr; // Scope holding the variable, or nullptr if it wasn't found.
+		uint64_t resolved_at = 0; // Value of the blackboard layout clock at the read.
+		uint32_t scope = 0; // Index in scopes of the blackboard the lookup started at.
+	};
+	static constexpr uint64_t UNTRACKED = UINT64_MAX;
+
+	static thread_local BBReadTracker *current;
+
+	LocalVector<Read> reads;
+	LocalVector<Ref<Blackboard>> scopes; // Kept alive so that their chains can be checked later.
+	BBReadTracker *prev = nullptr;
+
+	static void _record(const BBVariable &p_var, uint64_t p_version, const Blackboard *p_scope, const Blackboard *p_owner, uint64_t p_resolved_at);
+	uint32_t _add_scope(const Blackboard *p_scope);
+
+public:
+	_FORCE_INLINE_ static void record_read(const BBVariable &p_var, const Blackboard *p_scope, const Blackboard *p_owner) {
+		if (unlikely(current)) {
+			_record(p_var, p_var.is_bound() ? UNTRACKED : p_var.get_version(), p_scope, p_owner, Blackboard::layout_clock.get());
+		}
+	}
+	_FORCE_INLINE_ static void record_missing(const Blackboard *p_scope) {
+		if (unlikely(current)) {
+			_record(BBVariable(), 0, p_scope, nullptr, Blackboard::layout_clock.get());
+		}
+	}
+
+	void begin();
+	void end();
+
+	// Re-records all reads in the enclosing trackers, as if they were repeated.
+	void forward() const;
+
+	bool has_changes() const;
+
+	_FORCE_INLINE_ int size() const { return reads.size(); }
+	_FORCE_INLINE_ void truncate(int p_size) { reads.resize(p_size); }
+	_FORCE_INLINE_ void clear() {
+		reads.clear();
+		scopes.clear();
+	}
+};
+
+#endif // BB_READ_TRACKER_H
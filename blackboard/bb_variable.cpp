@@ -14,8 +14,75 @@
 #include "../compat/object.h"
 #include "../compat/variant.h"
 
+#ifdef LIMBOAI_MODULE
+#include "core/object/class_db.h"
+#include "core/object/method_bind.h"
+#include "core/os/mutex.h"
+
+// * Pointers to a bound object cached by variables, cleared when the object is freed.
+// * Attached to the object as an instance binding, since its free callback is called on deletion.
+struct BBBoundObjectTracker {
+	LocalVector<Object **> pointers;
+};
+
+static Mutex bound_tracker_mutex;
+static int bound_tracker_token = 0; // * Only its address is used.
+
+static void *_bound_tracker_create(void *p_token, void *p_instance) {
+	return memnew(BBBoundObjectTracker);
+}
+
+static void _bound_tracker_free(void *p_token, void *p_instance, void *p_binding) {
+	BBBoundObjectTracker *tracker = (BBBoundObjectTracker *)p_binding;
+	{
+		MutexLock lock(bound_tracker_mutex);
+		for (Object **ptr : tracker->pointers) {
+			*ptr = nullptr;
+		}
+	}
+	memdelete(tracker);
+}
+
+static GDExtensionBool _bound_tracker_reference(void *p_token, void *p_binding, GDExtensionBool p_reference) {
+	return true;
+}
+
+static const GDExtensionInstanceBindingCallbacks bound_tracker_callbacks = {
+	&_bound_tracker_create,
+	&_bound_tracker_free,
+	&_bound_tracker_reference,
+};
+
+static void _untrack_bound_object(Object **r_ptr) {
+	MutexLock lock(bound_tracker_mutex);
+	if (*r_ptr == nullptr) {
+		return;
+	}
+	BBBoundObjectTracker *tracker = (BBBoundObjectTracker *)(*r_ptr)->get_instance_binding(&bound_tracker_token, nullptr);
+	if (tracker) {
+		tracker->pointers.erase(r_ptr);
+	}
+	*r_ptr = nullptr;
+}
+
+static void _track_bound_object(Object **r_ptr, Object *p_object) {
+	_untrack_bound_object(r_ptr);
+	if (p_object == nullptr) {
+		return;
+	}
+	BBBoundObjectTracker *tracker = (BBBoundObjectTracker *)p_object->get_instance_binding(&bound_tracker_token, &bound_tracker_callbacks);
+	ERR_FAIL_NULL(tracker);
+	MutexLock lock(bound_tracker_mutex);
+	tracker->pointers.push_back(r_ptr);
+	*r_ptr = p_object;
+}
+#endif // LIMBOAI_MODULE
+
 void BBVariable::unref() {
 	if (data && data->refcount.unref()) {
+#ifdef LIMBOAI_MODULE
+		_untrack_bound_object(&data->bound_ptr);
+#endif
 		memdelete(data);
 	}
 	data = nullptr;
@@ -24,25 +91,118 @@ void BBVariable::unref() {
 void BBVariable::set_value(const Variant &p_value) {
 	data->value = p_value; // Setting value even when bound as a fallback in case the binding fails.
 	data->value_changed = true;
+	data->version += 1;
 
 	if (is_bound()) {
+#ifdef LIMBOAI_MODULE
+		Object *obj = data->bound_ptr;
+#elif LIMBOAI_GDEXTENSION
 		Object *obj = OBJECT_DB_GET_INSTANCE(data->bound_object);
-		ERR_FAIL_COND_MSG(!obj, "Blackboard: Failed to get bound object.");
+#endif
+		if (likely(obj)) {
 #ifdef LIMBOAI_MODULE
-		bool r_valid;
-		obj->set(data->bound_property, p_value, &r_valid);
-		ERR_FAIL_COND_MSG(!r_valid, vformat("Blackboard: Failed to set bound property `%s` on %s", data->bound_property, obj));
+			if (!_set_bound_fast(obj, p_value)) {
+				bool r_valid;
+				obj->set(data->bound_property, p_value, &r_valid);
+				if (unlikely(!r_valid)) {
+					ERR_PRINT(vformat("Blackboard: Failed to set bound property `%s` on %s", data->bound_property, obj));
+				}
+			}
 #elif LIMBOAI_GDEXTENSION
-		obj->set(data->bound_property, p_value);
+			obj->set(data->bound_property, p_value);
 #endif
+		} else {
+			ERR_PRINT("Blackboard: Failed to get bound object.");
+		}
+	}
+
+	if (unlikely(data->observer_list)) {
+		_notify_observers(p_value);
+	}
+}
+
+void BBVariable::_notify_observers(const Variant &p_value) {
+	// * Keep the data alive in case an observer releases the last reference to it,
+	// * which may also destroy this BBVariable.
+	BBVariable guard(*this);
+	Data *d = guard.data;
+	ObserverList *list = d->observer_list;
+	list->notify_depth += 1;
+	// * Observers added during notification are not notified until the next write.
+	const uint32_t count = list->observers.size();
+	for (uint32_t i = 0; i < count; i++) {
+		// * Copy, as the vector may be reallocated by observers added in the meantime.
+		const Observer observer = list->observers[i];
+		if (observer.id == 0) {
+			continue;
+		}
+		if (observer.func) {
+			observer.func(observer.userdata, observer.name, p_value);
+		} else {
+			observer.callable.call(observer.name, p_value);
+		}
+	}
+	list->notify_depth -= 1;
+	if (list->notify_depth == 0 && list->has_tombstones) {
+		for (uint32_t i = 0; i < list->observers.size();) {
+			if (list->observers[i].id == 0) {
+				list->observers.remove_at(i);
+			} else {
+				i++;
+			}
+		}
+		list->has_tombstones = false;
+		if (list->observers.is_empty()) {
+			memdelete(list);
+			d->observer_list = nullptr;
+		}
+	}
+}
+
+void BBVariable::add_observer(const Observer &p_observer) {
+	ERR_FAIL_COND(p_observer.id == 0);
+	if (data->observer_list == nullptr) {
+		data->observer_list = memnew(ObserverList);
+	}
+	data->observer_list->observers.push_back(p_observer);
+}
+
+void BBVariable::remove_observer(uint64_t p_id) {
+	ObserverList *list = data->observer_list;
+	if (list == nullptr) {
+		return;
+	}
+	for (uint32_t i = 0; i < list->observers.size(); i++) {
+		if (list->observers[i].id != p_id) {
+			continue;
+		}
+		if (list->notify_depth > 0) {
+			list->observers[i].id = 0;
+			list->has_tombstones = true;
+			return;
+		}
+		list->observers.remove_at(i);
+		break;
+	}
+	if (list->observers.is_empty()) {
+		memdelete(list);
+		data->observer_list = nullptr;
 	}
 }
 
 Variant BBVariable::get_value() const {
 	if (is_bound()) {
+#ifdef LIMBOAI_MODULE
+		Object *obj = data->bound_ptr;
+#elif LIMBOAI_GDEXTENSION
 		Object *obj = OBJECT_DB_GET_INSTANCE(data->bound_object);
+#endif
 		ERR_FAIL_COND_V_MSG(!obj, data->value, "Blackboard: Failed to get bound object.");
 #ifdef LIMBOAI_MODULE
+		Variant fast_ret;
+		if (_get_bound_fast(obj, fast_ret)) {
+			return fast_ret;
+		}
 		bool r_valid;
 		Variant ret = obj->get(data->bound_property, &r_valid);
 		ERR_FAIL_COND_V_MSG(!r_valid, data->value, vformat("Blackboard: Failed to get bound property `%s` on %s", data->bound_property, obj));
@@ -92,6 +252,12 @@ BBVariable BBVariable::duplicate(bool p_deep) const {
 	var.data->binding_path = data->binding_path;
 	var.data->bound_object = data->bound_object;
 	var.data->bound_property = data->bound_property;
+#ifdef LIMBOAI_MODULE
+	_track_bound_object(&var.data->bound_ptr, data->bound_ptr);
+	var.data->bound_getter = data->bound_getter;
+	var.data->bound_setter = data->bound_setter;
+	var.data->bound_index = data->bound_index;
+#endif
 	return var;
 }
 
@@ -120,12 +286,74 @@ void BBVariable::bind(Object *p_object, const StringName &p_property) {
 	ERR_FAIL_COND_MSG(!OBJECT_HAS_PROPERTY(p_object, p_property), vformat("Blackboard: Binding failed - %s has no property `%s`.", p_object, p_property));
 	data->bound_object = p_object->get_instance_id();
 	data->bound_property = p_property;
+#ifdef LIMBOAI_MODULE
+	_track_bound_object(&data->bound_ptr, p_object);
+	_resolve_bound_accessors(p_object);
+#endif
 }
 
 void BBVariable::unbind() {
 	data->bound_object = 0;
 	data->bound_property = StringName();
+#ifdef LIMBOAI_MODULE
+	_untrack_bound_object(&data->bound_ptr);
+	_resolve_bound_accessors(nullptr);
+#endif
+}
+
+#ifdef LIMBOAI_MODULE
+void BBVariable::_resolve_bound_accessors(Object *p_object) {
+	data->bound_getter = nullptr;
+	data->bound_setter = nullptr;
+	data->bound_index = -1;
+	if (p_object == nullptr) {
+		return;
+	}
+	const StringName class_name = p_object->get_class_name();
+	bool is_native = false;
+	const int index = ClassDB::get_property_index(class_name, data->bound_property, &is_native);
+	if (!is_native) {
+		// * Script members and dynamic properties go through Object::get/set.
+		return;
+	}
+	data->bound_index = index;
+	data->bound_getter = ClassDB::get_method(class_name, ClassDB::get_property_getter(class_name, data->bound_property));
+	data->bound_setter = ClassDB::get_method(class_name, ClassDB::get_property_setter(class_name, data->bound_property));
+}
+
+// Calls the cached getter directly, skipping property lookup by name. Returns false if unavailable or failed.
+bool BBVariable::_get_bound_fast(Object *p_object, Variant &r_value) const {
+	// * A script may override the property through _get()/_set(), so scripted objects take the full path.
+	if (data->bound_getter == nullptr || p_object->get_script_instance() != nullptr) {
+		return false;
+	}
+	Callable::CallError ce;
+	if (data->bound_index >= 0) {
+		const Variant index = data->bound_index;
+		const Variant *args[1] = { &index };
+		r_value = data->bound_getter->call(p_object, args, 1, ce);
+	} else {
+		r_value = data->bound_getter->call(p_object, nullptr, 0, ce);
+	}
+	return ce.error == Callable::CallError::CALL_OK;
+}
+
+bool BBVariable::_set_bound_fast(Object *p_object, const Variant &p_value) const {
+	if (data->bound_setter == nullptr || p_object->get_script_instance() != nullptr) {
+		return false;
+	}
+	Callable::CallError ce;
+	if (data->bound_index >= 0) {
+		const Variant index = data->bound_index;
+		const Variant *args[2] = { &index, &p_value };
+		data->bound_setter->call(p_object, args, 2, ce);
+	} else {
+		const Variant *args[1] = { &p_value };
+		data->bound_setter->call(p_object, args, 1, ce);
+	}
+	return ce.error == Callable::CallError::CALL_OK;
 }
+#endif // LIMBOAI_MODULE
 
 bool BBVariable::operator==(const BBVariable &p_var) const {
 	if (data == p_var.data) {
@@ -14,20 +14,48 @@
 
 #ifdef LIMBOAI_MODULE
 #include "core/object/object.h"
+#include "core/templates/local_vector.h"
+
+class MethodBind;
 #endif // LIMBOAI_MODULE
 
 #ifdef LIMBOAI_GDEXTENSION
 #include <godot_cpp/core/defs.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
 #include <godot_cpp/templates/safe_refcount.hpp>
+#include <godot_cpp/variant/callable.hpp>
 #include <godot_cpp/variant/variant.hpp>
 using namespace godot;
 #endif // LIMBOAI_GDEXTENSION
 
 class BBVariable {
+public:
+	typedef void (*ObserverFunc)(void *p_userdata, const StringName &p_name, const Variant &p_value);
+
+	// Notified after each write to the variable. Either func or callable is set.
+	struct Observer {
+		uint64_t id = 0;
+		StringName name; // Name under which the variable was observed.
+		ObserverFunc func = nullptr;
+		void *userdata = nullptr;
+		Callable callable;
+	};
+
 private:
+	struct ObserverList {
+		LocalVector<Observer> observers;
+		// Observers removed during notification are tombstoned (id = 0) and compacted afterwards.
+		int notify_depth = 0;
+		bool has_tombstones = false;
+	};
+
 	struct Data {
 		// Is used to decide if the value needs to be synced in a derived plan.
 		bool value_changed = false;
+		// Incremented on every write; lets readers detect changes without comparing values.
+		uint64_t version = 0;
+		// Number of blackboard scopes holding the variable; more than one if it's linked.
+		uint32_t num_owners = 0;
 
 		SafeRefCount refcount;
 		Variant value;
@@ -38,15 +66,42 @@ private:
 		NodePath binding_path;
 		uint64_t bound_object = 0;
 		StringName bound_property;
+#ifdef LIMBOAI_MODULE
+		// Bound object, cached at binding and cleared when the object is freed.
+		// The GDExtension build has no deletion hook and looks the object up by bound_object instead.
+		Object *bound_ptr = nullptr;
+		// Accessors of the bound property, resolved once if it's a native property of the bound object.
+		MethodBind *bound_getter = nullptr;
+		MethodBind *bound_setter = nullptr;
+		int bound_index = -1;
+#endif
+
+		ObserverList *observer_list = nullptr;
+
+		~Data() {
+			if (observer_list) {
+				memdelete(observer_list);
+			}
+		}
 	};
 
 	Data *data = nullptr;
 	void unref();
+	void _notify_observers(const Variant &p_value);
+
+#ifdef LIMBOAI_MODULE
+	void _resolve_bound_accessors(Object *p_object);
+	bool _get_bound_fast(Object *p_object, Variant &r_value) const;
+	bool _set_bound_fast(Object *p_object, const Variant &p_value) const;
+#endif
 
 public:
 	void set_value(const Variant &p_value);
 	Variant get_value() const;
 
+	// Stored value without copying; nullptr if the variable is bound to a property.
+	_FORCE_INLINE_ const Variant *get_value_ptr() const { return is_bound() ? nullptr : &data->value; }
+
 	void set_type(Variant::Type p_type);
 	Variant::Type get_type() const;
 
@@ -58,6 +113,17 @@ public:
 
 	BBVariable duplicate(bool p_deep = false) const;
 
+	_FORCE_INLINE_ uint64_t get_version() const { return data->version; }
+
+	// * Maintained by Blackboard, see Blackboard::is_shared().
+	_FORCE_INLINE_ uint32_t get_owner_count() const { return data->num_owners; }
+	_FORCE_INLINE_ void add_owner() { data->num_owners += 1; }
+	_FORCE_INLINE_ void remove_owner() { data->num_owners -= 1; }
+
+	void add_observer(const Observer &p_observer);
+	void remove_observer(uint64_t p_id);
+	_FORCE_INLINE_ bool has_observers() const { return data->observer_list != nullptr; }
+
 	_FORCE_INLINE_ bool is_value_changed() const { return data->value_changed; }
 	_FORCE_INLINE_ void reset_value_changed() { data->value_changed = false; }
 
@@ -10,7 +10,13 @@
  */
 
 #include "blackboard.h"
+
 #include "../compat/print.h"
+#include "bb_read_tracker.h"
+
+SafeNumeric<uint64_t> Blackboard::layout_clock;
+SafeNumeric<uint64_t> Blackboard::last_observer_id;
+SafeNumeric<uint64_t> Blackboard::unshare_clock;
 
 Ref<Blackboard> Blackboard::top() const {
 	Ref<Blackboard> bb(this);
@@ -21,46 +27,352 @@ Ref<Blackboard> Blackboard::top() const {
 }
 
 Variant Blackboard::get_var(const StringName &p_name, const Variant &p_default, bool p_complain) const {
-	if (data.has(p_name)) {
-		return data.get(p_name).get_value();
-	} else if (parent.is_valid()) {
-		return parent->get_var(p_name, p_default, p_complain);
+	const Blackboard *owner = nullptr;
+	const BBVariable *var = _find_var(p_name, &owner);
+	if (likely(var)) {
+		BBReadTracker::record_read(*var, this, owner);
+		return var->get_value();
+	}
+	BBReadTracker::record_missing(this);
+	if (p_complain) {
+		ERR_PRINT(vformat("Blackboard: Variable \"%s\" not found.", p_name));
+	}
+	return p_default;
+}
+
+void Blackboard::_write_var(BBVariable &p_var, const Variant &p_value) {
+	if (unlikely(p_var.has_observers() || p_var.is_bound())) {
+		// * Observers and property setters run arbitrary code, which may add variables and move the storage.
+		BBVariable var = p_var;
+		var.set_value(p_value);
 	} else {
-		if (p_complain) {
-			ERR_PRINT(vformat("Blackboard: Variable \"%s\" not found.", p_name));
+		p_var.set_value(p_value);
+	}
+}
+
+void Blackboard::_add_var(const StringName &p_name, const BBVariable &p_var) {
+	var_indices.insert(p_name, vars.size());
+	vars.push_back(p_var);
+	vars[vars.size() - 1].add_owner();
+	var_names.push_back(p_name);
+	_layout_changed();
+}
+
+void Blackboard::_replace_var(BBVariable &r_var, const BBVariable &p_new_var) {
+	r_var.remove_owner();
+	r_var = p_new_var;
+	r_var.add_owner();
+	unshare_clock.increment();
+	_layout_changed();
+}
+
+bool Blackboard::_update_shared() const {
+	shared_checked_at = unshare_clock.get();
+	for (const BBVariable &var : vars) {
+		if (var.has_observers() || var.is_bound() || var.get_owner_count() > 1) {
+			return true;
 		}
-		return p_default;
 	}
+	shared = false;
+	return false;
 }
 
 void Blackboard::set_var(const StringName &p_name, const Variant &p_value) {
-	if (data.has(p_name)) {
+	BBVariable *var = _get_local_var(p_name);
+	if (var) {
 		// Not checking type - allowing duck-typing.
-		data[p_name].set_value(p_value);
+		_write_var(*var, p_value);
+		version += 1;
 	} else {
-		BBVariable var(p_value.get_type());
-		var.set_value(p_value);
-		data.insert(p_name, var);
+		BBVariable new_var(p_value.get_type());
+		new_var.set_value(p_value);
+		_add_var(p_name, new_var);
 	}
 }
 
 bool Blackboard::has_var(const StringName &p_name) const {
-	return data.has(p_name) || (parent.is_valid() && parent->has_var(p_name));
+	if (_find_var(p_name)) {
+		return true;
+	}
+	BBReadTracker::record_missing(this);
+	return false;
 }
 
 void Blackboard::erase_var(const StringName &p_name) {
-	data.erase(p_name);
+	const uint32_t *idx = var_indices.getptr(p_name);
+	if (idx == nullptr) {
+		return;
+	}
+	// * Keep insertion order: shift the following variables down.
+	const uint32_t removed = *idx;
+	var_indices.erase(p_name);
+	vars[removed].remove_owner();
+	vars.remove_at(removed);
+	var_names.remove_at(removed);
+	for (uint32_t i = removed; i < vars.size(); i++) {
+		var_indices[var_names[i]] = i;
+	}
+	unshare_clock.increment();
+	_layout_changed();
+}
+
+void Blackboard::clear() {
+	for (BBVariable &var : vars) {
+		var.remove_owner();
+	}
+	unshare_clock.increment();
+	vars.clear();
+	var_names.clear();
+	var_indices.clear();
+	_layout_changed();
 }
 
 TypedArray<StringName> Blackboard::list_vars() const {
-	TypedArray<StringName> var_names;
-	var_names.resize(data.size());
-	int idx = 0;
-	for (const KeyValue<StringName, BBVariable> &kv : data) {
-		var_names[idx] = kv.key;
-		idx += 1;
+	TypedArray<StringName> names;
+	names.resize(var_names.size());
+	for (uint32_t i = 0; i < var_names.size(); i++) {
+		names[i] = var_names[i];
+	}
+	return names;
+}
+
+bool Blackboard::_is_lookup_valid(const Blackboard *p_owner, uint64_t p_resolved_at) const {
+	for (const Blackboard *bb = this; bb != nullptr; bb = bb->parent.ptr()) {
+		if (bb->layout_stamp > p_resolved_at) {
+			return false;
+		}
+		if (bb == p_owner) {
+			return true;
+		}
 	}
-	return var_names;
+	// * Lookups that found nothing depend on the whole chain.
+	return p_owner == nullptr;
+}
+
+void Blackboard::_resolve_slot(Slot &p_slot) const {
+	p_slot.resolved_at = layout_clock.get();
+	p_slot.owner = nullptr;
+	for (const Blackboard *bb = this; bb != nullptr; bb = bb->parent.ptr()) {
+		const uint32_t *idx = bb->var_indices.getptr(p_slot.name);
+		if (idx) {
+			p_slot.owner = const_cast<Blackboard *>(bb);
+			p_slot.index = *idx;
+			return;
+		}
+	}
+}
+
+BBVariable *Blackboard::_get_slot_var(int p_handle) const {
+	Slot &slot = slots[p_handle];
+	if (unlikely(!_is_slot_valid(slot))) {
+		_resolve_slot(slot);
+	}
+	return slot.owner ? &slot.owner->vars[slot.index] : nullptr;
+}
+
+int Blackboard::_get_slot_index(const StringName &p_name) {
+	const int *idx = slot_indices.getptr(p_name);
+	if (likely(idx)) {
+		return *idx;
+	}
+	Slot slot;
+	slot.name = p_name;
+	_resolve_slot(slot);
+	slots.push_back(slot);
+	slot_indices.insert(p_name, slots.size() - 1);
+	return slots.size() - 1;
+}
+
+const BBVariable *Blackboard::_find_var(const StringName &p_name, const Blackboard **r_owner) const {
+	const uint32_t *idx = var_indices.getptr(p_name);
+	if (likely(idx)) {
+		if (r_owner) {
+			*r_owner = this;
+		}
+		return &vars[*idx];
+	}
+	if (parent.is_null()) {
+		return nullptr;
+	}
+	// * Reuse a memoized slot if it's still valid, otherwise walk the chain. Nothing is cached on read.
+	const int *handle = slot_indices.getptr(p_name);
+	if (handle) {
+		const Slot &slot = slots[*handle];
+		if (likely(_is_slot_valid(slot))) {
+			if (r_owner) {
+				*r_owner = slot.owner;
+			}
+			return slot.owner ? &slot.owner->vars[slot.index] : nullptr;
+		}
+	}
+	for (const Blackboard *bb = parent.ptr(); bb != nullptr; bb = bb->parent.ptr()) {
+		idx = bb->var_indices.getptr(p_name);
+		if (idx) {
+			if (r_owner) {
+				*r_owner = bb;
+			}
+			return &bb->vars[*idx];
+		}
+	}
+	return nullptr;
+}
+
+int Blackboard::get_var_handle(const StringName &p_name) {
+	if (p_name == StringName()) {
+		return -1;
+	}
+	return _get_slot_index(p_name);
+}
+
+Variant Blackboard::get_var_by_handle(int p_handle, const Variant &p_default, bool p_complain) const {
+	ERR_FAIL_INDEX_V(p_handle, (int)slots.size(), p_default);
+	const BBVariable *var = _get_slot_var(p_handle);
+	if (likely(var)) {
+		BBReadTracker::record_read(*var, this, slots[p_handle].owner);
+		return var->get_value();
+	}
+	BBReadTracker::record_missing(this);
+	if (p_complain) {
+		ERR_PRINT(vformat("Blackboard: Variable \"%s\" not found.", slots[p_handle].name));
+	}
+	return p_default;
+}
+
+void Blackboard::set_var_by_handle(int p_handle, const Variant &p_value) {
+	ERR_FAIL_INDEX(p_handle, (int)slots.size());
+	BBVariable *var = _get_slot_var(p_handle);
+	if (likely(var && slots[p_handle].owner == this)) {
+		_write_var(*var, p_value);
+		version += 1;
+	} else {
+		// * Same as set_var(): the variable is created in this scope.
+		set_var(slots[p_handle].name, p_value);
+	}
+}
+
+bool Blackboard::has_var_by_handle(int p_handle) const {
+	if (unlikely(p_handle < 0 || p_handle >= (int)slots.size())) {
+		return false;
+	}
+	if (_get_slot_var(p_handle) == nullptr) {
+		BBReadTracker::record_missing(this);
+		return false;
+	}
+	return true;
+}
+
+uint64_t Blackboard::get_var_version(const StringName &p_name) const {
+	const BBVariable *var = _find_var(p_name);
+	return var ? var->get_version() : 0;
+}
+
+uint64_t Blackboard::get_var_version_by_handle(int p_handle) const {
+	ERR_FAIL_INDEX_V(p_handle, (int)slots.size(), 0);
+	const BBVariable *var = _get_slot_var(p_handle);
+	return var ? var->get_version() : 0;
+}
+
+uint64_t Blackboard::_add_observer(const StringName *p_names, int p_count, BBVariable::ObserverFunc p_func, void *p_userdata, const Callable &p_callable) {
+	ERR_FAIL_COND_V_MSG(p_count == 0, 0, "Blackboard: No variables to observe.");
+	ERR_FAIL_COND_V(p_func == nullptr && !p_callable.is_valid(), 0);
+
+	LocalVector<BBVariable> observed;
+	observed.reserve(p_count);
+	for (int i = 0; i < p_count; i++) {
+		const int handle = _get_slot_index(p_names[i]);
+		const BBVariable *var = _get_slot_var(handle);
+		ERR_FAIL_NULL_V_MSG(var, 0, vformat("Blackboard: Can't observe variable that doesn't exist (var: %s).", p_names[i]));
+		observed.push_back(*var);
+	}
+	// * Observers may run arbitrary code on writes: mark the scopes owning the variables.
+	for (int i = 0; i < p_count; i++) {
+		slots[slot_indices[p_names[i]]].owner->shared = true;
+	}
+
+	BBVariable::Observer observer;
+	observer.id = last_observer_id.increment();
+	observer.func = p_func;
+	observer.userdata = p_userdata;
+	observer.callable = p_callable;
+	for (int i = 0; i < p_count; i++) {
+		observer.name = p_names[i];
+		observed[i].add_observer(observer);
+	}
+	observers.insert(observer.id, observed);
+	return observer.id;
+}
+
+uint64_t Blackboard::observe_var_callable(const StringName &p_name, const Callable &p_callable) {
+	return _add_observer(&p_name, 1, nullptr, nullptr, p_callable);
+}
+
+uint64_t Blackboard::observe_vars_callable(const TypedArray<StringName> &p_names, const Callable &p_callable) {
+	LocalVector<StringName> names;
+	names.resize(p_names.size());
+	for (int i = 0; i < p_names.size(); i++) {
+		names[i] = p_names[i];
+	}
+	return _add_observer(names.ptr(), names.size(), nullptr, nullptr, p_callable);
+}
+
+void Blackboard::remove_observer(uint64_t p_id) {
+	LocalVector<BBVariable> *vars = observers.getptr(p_id);
+	ERR_FAIL_NULL_MSG(vars, vformat("Blackboard: Observer %d doesn't exist in this blackboard.", p_id));
+	for (BBVariable &var : *vars) {
+		var.remove_observer(p_id);
+	}
+	observers.erase(p_id);
+	unshare_clock.increment();
+}
+
+template <typename T, Variant::Type TYPE>
+T Blackboard::_get_typed_by_handle(int p_handle, const T &p_default) const {
+	ERR_FAIL_INDEX_V(p_handle, (int)slots.size(), p_default);
+	const BBVariable *var = _get_slot_var(p_handle);
+	if (unlikely(var == nullptr)) {
+		BBReadTracker::record_missing(this);
+		ERR_PRINT(vformat("Blackboard: Variable \"%s\" not found.", slots[p_handle].name));
+		return p_default;
+	}
+	BBReadTracker::record_read(*var, this, slots[p_handle].owner);
+	const Variant *value = var->get_value_ptr();
+	if (likely(value && value->get_type() == TYPE)) {
+		return *value;
+	}
+	const Variant converted = var->get_value();
+	ERR_FAIL_COND_V_MSG(!Variant::can_convert(converted.get_type(), TYPE), p_default,
+			vformat("Blackboard: Variable \"%s\" of type %s can't be converted to %s.", slots[p_handle].name, Variant::get_type_name(converted.get_type()), Variant::get_type_name(TYPE)));
+	return converted;
+}
+
+Variant::Type Blackboard::get_var_type_by_handle(int p_handle) const {
+	ERR_FAIL_INDEX_V(p_handle, (int)slots.size(), Variant::NIL);
+	const BBVariable *var = _get_slot_var(p_handle);
+	if (var == nullptr) {
+		return Variant::NIL;
+	}
+	const Variant *value = var->get_value_ptr();
+	return value ? value->get_type() : var->get_type();
+}
+
+bool Blackboard::get_bool_by_handle(int p_handle, bool p_default) const {
+	return _get_typed_by_handle<bool, Variant::BOOL>(p_handle, p_default);
+}
+
+int64_t Blackboard::get_int_by_handle(int p_handle, int64_t p_default) const {
+	return _get_typed_by_handle<int64_t, Variant::INT>(p_handle, p_default);
+}
+
+double Blackboard::get_float_by_handle(int p_handle, double p_default) const {
+	return _get_typed_by_handle<double, Variant::FLOAT>(p_handle, p_default);
+}
+
+Vector2 Blackboard::get_vector2_by_handle(int p_handle, const Vector2 &p_default) const {
+	return _get_typed_by_handle<Vector2, Variant::VECTOR2>(p_handle, p_default);
+}
+
+Vector3 Blackboard::get_vector3_by_handle(int p_handle, const Vector3 &p_default) const {
+	return _get_typed_by_handle<Vector3, Variant::VECTOR3>(p_handle, p_default);
 }
 
 void Blackboard::print_state() const {
@@ -69,11 +381,11 @@ void Blackboard::print_state() const {
 	while (bb.is_valid()) {
 		int i = 0;
 		String line = "Scope " + itos(scope_idx) + ": { ";
-		for (const KeyValue<StringName, BBVariable> &kv : bb->data) {
+		for (uint32_t j = 0; j < bb->vars.size(); j++) {
 			if (i > 0) {
 				line += ", ";
 			}
-			line += String(kv.key) + ": " + String(kv.value.get_value());
+			line += String(bb->var_names[j]) + ": " + String(bb->vars[j].get_value());
 			i++;
 		}
 		line += " }";
@@ -85,8 +397,8 @@ void Blackboard::print_state() const {
 
 Dictionary Blackboard::get_vars_as_dict() const {
 	Dictionary dict;
-	for (const KeyValue<StringName, BBVariable> &kv : data) {
-		dict[kv.key] = kv.value.get_value();
+	for (uint32_t i = 0; i < vars.size(); i++) {
+		dict[var_names[i]] = vars[i].get_value();
 	}
 	return dict;
 }
@@ -103,36 +415,60 @@ void Blackboard::populate_from_dict(const Dictionary &p_dictionary) {
 }
 
 void Blackboard::bind_var_to_property(const StringName &p_name, Object *p_object, const StringName &p_property, bool p_create) {
-	if (!data.has(p_name)) {
+	if (!var_indices.has(p_name)) {
 		if (p_create) {
-			data.insert(p_name, BBVariable());
+			_add_var(p_name, BBVariable());
 		} else {
 			ERR_FAIL_MSG("Blackboard: Can't bind variable that doesn't exist (var: " + p_name + ").");
 		}
 	}
-	data[p_name].bind(p_object, p_property);
+	_get_local_var(p_name)->bind(p_object, p_property);
+	shared = true;
 }
 
 void Blackboard::unbind_var(const StringName &p_name) {
-	ERR_FAIL_COND_MSG(!data.has(p_name), "Blackboard: Can't unbind variable that doesn't exist (var: " + p_name + ").");
-	data[p_name].unbind();
+	BBVariable *var = _get_local_var(p_name);
+	ERR_FAIL_NULL_MSG(var, "Blackboard: Can't unbind variable that doesn't exist (var: " + p_name + ").");
+	var->unbind();
+	unshare_clock.increment();
 }
 
 void Blackboard::assign_var(const StringName &p_name, const BBVariable &p_var) {
-	data.insert(p_name, p_var);
+	BBVariable *var = _get_local_var(p_name);
+	if (var) {
+		_replace_var(*var, p_var);
+	} else {
+		_add_var(p_name, p_var);
+	}
 }
 
 void Blackboard::link_var(const StringName &p_name, const Ref<Blackboard> &p_target_blackboard, const StringName &p_target_var, bool p_create) {
-	if (!data.has(p_name)) {
+	if (!var_indices.has(p_name)) {
 		if (p_create) {
-			data.insert(p_name, BBVariable());
+			_add_var(p_name, BBVariable());
 		} else {
 			ERR_FAIL_MSG("Blackboard: Can't link variable that doesn't exist (var: " + p_name + ").");
 		}
 	}
 	ERR_FAIL_COND_MSG(p_target_blackboard.is_null(), "Blackboard: Can't link variable to target blackboard that is null (var: " + p_name + ").");
-	ERR_FAIL_COND_MSG(!p_target_blackboard->data.has(p_target_var), "Blackboard: Can't link variable to non-existent target (var: " + p_name + ", target: " + p_target_var + ").");
-	data[p_name] = p_target_blackboard->data[p_target_var];
+	BBVariable *target = p_target_blackboard->_get_local_var(p_target_var);
+	ERR_FAIL_NULL_MSG(target, "Blackboard: Can't link variable to non-existent target (var: " + p_name + ", target: " + p_target_var + ").");
+	_replace_var(*_get_local_var(p_name), *target);
+	shared = true;
+	p_target_blackboard->shared = true;
+}
+
+Blackboard::~Blackboard() {
+	// * Variables may outlive this blackboard through links.
+	for (KeyValue<uint64_t, LocalVector<BBVariable>> &kv : observers) {
+		for (BBVariable &var : kv.value) {
+			var.remove_observer(kv.key);
+		}
+	}
+	for (BBVariable &var : vars) {
+		var.remove_owner();
+	}
+	unshare_clock.increment();
 }
 
 void Blackboard::_bind_methods() {
@@ -150,5 +486,15 @@ void Blackboard::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("top"), &Blackboard::top);
 	ClassDB::bind_method(D_METHOD("bind_var_to_property", "var_name", "object", "property", "create"), &Blackboard::bind_var_to_property, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("unbind_var", "var_name"), &Blackboard::unbind_var);
+	ClassDB::bind_method(D_METHOD("get_var_handle", "var_name"), &Blackboard::get_var_handle);
+	ClassDB::bind_method(D_METHOD("get_var_by_handle", "handle", "default", "complain"), &Blackboard::get_var_by_handle, DEFVAL(Variant()), DEFVAL(true));
+	ClassDB::bind_method(D_METHOD("set_var_by_handle", "handle", "value"), &Blackboard::set_var_by_handle);
+	ClassDB::bind_method(D_METHOD("has_var_by_handle", "handle"), &Blackboard::has_var_by_handle);
+	ClassDB::bind_method(D_METHOD("get_version"), &Blackboard::get_version);
+	ClassDB::bind_method(D_METHOD("get_var_version", "var_name"), &Blackboard::get_var_version);
+	ClassDB::bind_method(D_METHOD("get_var_version_by_handle", "handle"), &Blackboard::get_var_version_by_handle);
+	ClassDB::bind_method(D_METHOD("observe_var", "var_name", "callable"), &Blackboard::observe_var_callable);
+	ClassDB::bind_method(D_METHOD("observe_vars", "var_names", "callable"), &Blackboard::observe_vars_callable);
+	ClassDB::bind_method(D_METHOD("remove_observer", "id"), &Blackboard::remove_observer);
 	ClassDB::bind_method(D_METHOD("link_var", "var_name", "target_blackboard", "target_var", "create"), &Blackboard::link_var, DEFVAL(false));
 }
@@ -17,6 +17,8 @@
 #ifdef LIMBOAI_MODULE
 #include "core/object/object.h"
 #include "core/object/ref_counted.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
 #include "core/variant/typed_array.h"
 #include "core/variant/variant.h"
 #endif // LIMBOAI_MODULE
@@ -26,17 +28,84 @@
 #include <godot_cpp/classes/ref_counted.hpp>
 #include <godot_cpp/core/object.hpp>
 #include <godot_cpp/templates/hash_map.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
+#include <godot_cpp/templates/safe_refcount.hpp>
+#include <godot_cpp/templates/vector.hpp>
 #include <godot_cpp/variant/typed_array.hpp>
 using namespace godot;
 #endif // LIMBOAI_GDEXTENSION
 
 class Blackboard : public RefCounted {
 	GDCLASS(Blackboard, RefCounted);
+	friend class BBReadTracker;
 
 private:
-	HashMap<StringName, BBVariable> data;
+	// A variable resolved by name through the scope chain, addressed by an integer handle.
+	struct Slot {
+		StringName name;
+		Blackboard *owner = nullptr; // Scope holding the variable, or nullptr if it wasn't found.
+		uint32_t index = 0; // Position in owner->vars.
+		uint64_t resolved_at = 0; // Value of layout_clock at resolution, see _is_slot_valid().
+	};
+
+	// Variables of this scope, stored densely in insertion order. var_indices maps names to positions.
+	LocalVector<BBVariable> vars;
+	LocalVector<StringName> var_names;
+	HashMap<StringName, uint32_t> var_indices;
 	Ref<Blackboard> parent;
 
+	// Slots are created by get_var_handle() and memoize which scope owns a variable; name-based reads
+	// reuse them but never add new ones. Reads only re-resolve existing stale slots in place.
+	mutable LocalVector<Slot> slots;
+	HashMap<StringName, int> slot_indices;
+
+	// Each scope is stamped with the next clock value whenever it adds, removes or replaces a variable,
+	// or changes its parent. A slot stays valid while no scope between this one and the owner is stamped
+	// after the slot was resolved, so changes to unrelated blackboards don't invalidate it.
+	static SafeNumeric<uint64_t> layout_clock;
+	uint64_t layout_stamp = 0;
+
+	// Incremented on every change made through this blackboard.
+	uint64_t version = 0;
+
+	// Set once any variable is linked to or from another blackboard, bound to a property, or observed.
+	// Such variables may be accessed outside the owning instance's thread, see BTInstance::is_thread_safe().
+	// Cleared by is_shared() once none of them is anymore.
+	mutable bool shared = false;
+	mutable uint64_t shared_checked_at = 0;
+	// Incremented whenever a link, binding or observer may have been removed from any blackboard.
+	static SafeNumeric<uint64_t> unshare_clock;
+	// Number of behavior tree instances using this blackboard as a scope, see BTInstance::is_thread_safe().
+	uint32_t num_instances = 0;
+
+	static SafeNumeric<uint64_t> last_observer_id;
+	// Variables each observer registered by this blackboard is attached to.
+	HashMap<uint64_t, LocalVector<BBVariable>> observers;
+
+	_FORCE_INLINE_ void _layout_changed() {
+		version += 1;
+		layout_stamp = layout_clock.increment();
+	}
+	_FORCE_INLINE_ BBVariable *_get_local_var(const StringName &p_name) {
+		const uint32_t *idx = var_indices.getptr(p_name);
+		return idx ? &vars[*idx] : nullptr;
+	}
+	void _add_var(const StringName &p_name, const BBVariable &p_var);
+	void _replace_var(BBVariable &r_var, const BBVariable &p_new_var);
+	bool _update_shared() const;
+	static void _write_var(BBVariable &p_var, const Variant &p_value);
+
+	uint64_t _add_observer(const StringName *p_names, int p_count, BBVariable::ObserverFunc p_func, void *p_userdata, const Callable &p_callable);
+	bool _is_lookup_valid(const Blackboard *p_owner, uint64_t p_resolved_at) const;
+	_FORCE_INLINE_ bool _is_slot_valid(const Slot &p_slot) const { return _is_lookup_valid(p_slot.owner, p_slot.resolved_at); }
+	void _resolve_slot(Slot &p_slot) const;
+	BBVariable *_get_slot_var(int p_handle) const;
+	int _get_slot_index(const StringName &p_name);
+	const BBVariable *_find_var(const StringName &p_name, const Blackboard **r_owner = nullptr) const;
+
+	template <typename T, Variant::Type TYPE>
+	T _get_typed_by_handle(int p_handle, const T &p_default) const;
+
 protected:
 	static void _bind_methods();
 
@@ -45,7 +114,10 @@ protected:
 #endif
 
 public:
-	void set_parent(const Ref<Blackboard> &p_blackboard) { parent = p_blackboard; }
+	void set_parent(const Ref<Blackboard> &p_blackboard) {
+		parent = p_blackboard;
+		_layout_changed();
+	}
 	Ref<Blackboard> get_parent() const { return parent; }
 
 	Ref<Blackboard> top() const;
@@ -53,12 +125,48 @@ public:
 	Variant get_var(const StringName &p_name, const Variant &p_default = Variant(), bool p_complain = true) const;
 	void set_var(const StringName &p_name, const Variant &p_value);
 	bool has_var(const StringName &p_name) const;
-	_FORCE_INLINE_ bool has_local_var(const StringName &p_name) const { return data.has(p_name); }
+	_FORCE_INLINE_ bool has_local_var(const StringName &p_name) const { return var_indices.has(p_name); }
 	void erase_var(const StringName &p_name);
-	void clear() { data.clear(); }
+	void clear();
 	TypedArray<StringName> list_vars() const;
 	void print_state() const;
 
+	int get_var_handle(const StringName &p_name);
+	Variant get_var_by_handle(int p_handle, const Variant &p_default = Variant(), bool p_complain = true) const;
+	void set_var_by_handle(int p_handle, const Variant &p_value);
+	bool has_var_by_handle(int p_handle) const;
+
+	uint64_t get_version() const { return version; }
+	_FORCE_INLINE_ bool is_shared() const { return shared && (shared_checked_at == unshare_clock.get() || _update_shared()); }
+	_FORCE_INLINE_ uint32_t get_instance_count() const { return num_instances; }
+	_FORCE_INLINE_ void add_instance() { num_instances += 1; }
+	_FORCE_INLINE_ void remove_instance() { num_instances -= 1; }
+	uint64_t get_var_version(const StringName &p_name) const;
+	uint64_t get_var_version_by_handle(int p_handle) const;
+
+	// * Observers are notified after each write to the variable, whichever blackboard or link it comes through.
+	uint64_t observe_var(const StringName &p_name, BBVariable::ObserverFunc p_func, void *p_userdata) { return _add_observer(&p_name, 1, p_func, p_userdata, Callable()); }
+	uint64_t observe_vars(const Vector<StringName> &p_names, BBVariable::ObserverFunc p_func, void *p_userdata) { return _add_observer(p_names.ptr(), p_names.size(), p_func, p_userdata, Callable()); }
+	uint64_t observe_var_callable(const StringName &p_name, const Callable &p_callable);
+	uint64_t observe_vars_callable(const TypedArray<StringName> &p_names, const Callable &p_callable);
+	void remove_observer(uint64_t p_id);
+
+	// * Typed access by handle for native code: conversions to and from the stored Variant.
+	// * Convertible types are converted; anything else returns the default with an error.
+	// * get_var_type_by_handle() tells which accessor matches: the type of the stored value
+	// * (the declared type if bound to a property), or NIL if the variable doesn't exist.
+	Variant::Type get_var_type_by_handle(int p_handle) const;
+	bool get_bool_by_handle(int p_handle, bool p_default = false) const;
+	int64_t get_int_by_handle(int p_handle, int64_t p_default = 0) const;
+	double get_float_by_handle(int p_handle, double p_default = 0.0) const;
+	Vector2 get_vector2_by_handle(int p_handle, const Vector2 &p_default = Vector2()) const;
+	Vector3 get_vector3_by_handle(int p_handle, const Vector3 &p_default = Vector3()) const;
+	_FORCE_INLINE_ void set_bool_by_handle(int p_handle, bool p_value) { set_var_by_handle(p_handle, p_value); }
+	_FORCE_INLINE_ void set_int_by_handle(int p_handle, int64_t p_value) { set_var_by_handle(p_handle, p_value); }
+	_FORCE_INLINE_ void set_float_by_handle(int p_handle, double p_value) { set_var_by_handle(p_handle, p_value); }
+	_FORCE_INLINE_ void set_vector2_by_handle(int p_handle, const Vector2 &p_value) { set_var_by_handle(p_handle, p_value); }
+	_FORCE_INLINE_ void set_vector3_by_handle(int p_handle, const Vector3 &p_value) { set_var_by_handle(p_handle, p_value); }
+
 	Dictionary get_vars_as_dict() const;
 	void populate_from_dict(const Dictionary &p_dictionary);
 
@@ -68,6 +176,8 @@ public:
 	void assign_var(const StringName &p_name, const BBVariable &p_var);
 
 	void link_var(const StringName &p_name, const Ref<Blackboard> &p_target_blackboard, const StringName &p_target_var, bool p_create = false);
+
+	~Blackboard();
 };
 
 #endif // BLACKBOARD_H
@@ -561,6 +561,11 @@ void BlackboardPlan::populate_blackboard(const Ref<Blackboard> &p_blackboard, bo
 			var.bind(n, prop_name);
 		}
 	}
+
+	// * Planned variables get the leading slots, in plan order.
+	for (const Pair<StringName, BBVariable> &p : var_list) {
+		p_blackboard->get_var_handle(p.first);
+	}
 }
 
 void BlackboardPlan::_bind_methods() {
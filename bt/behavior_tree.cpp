@@ -11,15 +11,19 @@
 
 #include "behavior_tree.h"
 
+#include "../compat/object.h"
 #include "../util/limbo_string_names.h"
 
 #ifdef LIMBOAI_MODULE
+#include "core/config/engine.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/variant/variant.h"
 #include "scene/main/node.h"
 #endif
 
 #ifdef LIMBOAI_GDEXTENSION
 #include <godot_cpp/classes/engine.hpp>
+#include <godot_cpp/classes/worker_thread_pool.hpp>
 #endif
 
 void BehaviorTree::set_description(const String &p_value) {
@@ -49,11 +53,18 @@ void BehaviorTree::set_blackboard_plan(const Ref<BlackboardPlan> &p_plan) {
 	_plan_changed();
 }
 
+void BehaviorTree::set_thread_safe(bool p_thread_safe) {
+	thread_safe = p_thread_safe;
+	prototype_generation += 1; // Existing instances keep the old setting.
+	emit_changed();
+}
+
 void BehaviorTree::set_root_task(const Ref<BTTask> &p_value) {
 #ifdef TOOLS_ENABLED
 	_unset_editor_behavior_tree_hint();
 #endif // TOOLS_ENABLED
 	root_task = p_value;
+	_invalidate_runtime_prototype();
 #ifdef TOOLS_ENABLED
 	_set_editor_behavior_tree_hint();
 #endif // TOOLS_ENABLED
@@ -72,7 +83,65 @@ Ref<BehaviorTree> BehaviorTree::clone() const {
 void BehaviorTree::copy_other(const Ref<BehaviorTree> &p_other) {
 	ERR_FAIL_COND(p_other.is_null());
 	description = p_other->get_description();
+	thread_safe = p_other->is_thread_safe();
 	root_task = p_other->get_root_task();
+	_invalidate_runtime_prototype();
+}
+
+Ref<BTTask> BehaviorTree::get_runtime_prototype() const {
+	if (root_task.is_null() || Engine::get_singleton()->is_editor_hint()) {
+		return root_task;
+	}
+	if (runtime_prototype.is_null()) {
+		runtime_prototype = root_task->clone();
+		if (runtime_prototype.is_null()) {
+			return runtime_prototype; // Disabled root task.
+		}
+		_mark_prototype(runtime_prototype.ptr());
+		// * Property setters and child changes emit "changed", so edits made at runtime reach new instances.
+		BehaviorTree *self = const_cast<BehaviorTree *>(this);
+		LocalVector<BTTask *> stack;
+		stack.push_back(root_task.ptr());
+		while (!stack.is_empty()) {
+			BTTask *task = stack[stack.size() - 1];
+			stack.resize(stack.size() - 1);
+			task->connect(LW_NAME(changed), callable_mp(self, &BehaviorTree::_invalidate_runtime_prototype));
+			prototype_sources.push_back(task);
+			if (Ref<Script>(GET_SCRIPT(task)).is_valid()) {
+				prototype_has_scripts = true;
+			}
+			for (int i = 0; i < task->get_child_count(); i++) {
+				stack.push_back(task->get_child_ptr(i));
+			}
+		}
+	}
+	return runtime_prototype;
+}
+
+void BehaviorTree::_mark_prototype(BTTask *p_task) {
+	p_task->data.prototype = true;
+	for (int i = 0; i < p_task->get_child_count(); i++) {
+		_mark_prototype(p_task->get_child_ptr(i));
+	}
+}
+
+void BehaviorTree::_invalidate_runtime_prototype() {
+	for (const Ref<BTTask> &task : prototype_sources) {
+		task->disconnect(LW_NAME(changed), callable_mp(this, &BehaviorTree::_invalidate_runtime_prototype));
+	}
+	prototype_sources.clear();
+	prototype_has_scripts = false;
+	runtime_prototype.unref();
+	runtime_layout = BTCompiledTree::Layout();
+	prototype_generation += 1;
+}
+
+Ref<BTInstance> BehaviorTree::_create_instance(const Ref<BTTask> &p_root_copy, Node *p_instance_owner) const {
+	Ref<BTInstance> inst = BTInstance::create(p_root_copy, get_path(), p_instance_owner, thread_safe, &runtime_layout);
+	ERR_FAIL_COND_V(inst.is_null(), nullptr);
+	inst->source_bt_id = get_instance_id();
+	inst->source_generation = prototype_generation;
+	return inst;
 }
 
 Ref<BTInstance> BehaviorTree::instantiate(Node *p_agent, const Ref<Blackboard> &p_blackboard, Node *p_instance_owner, Node *p_custom_scene_root) const {
@@ -82,9 +151,70 @@ Ref<BTInstance> BehaviorTree::instantiate(Node *p_agent, const Ref<Blackboard> &
 	ERR_FAIL_COND_V_MSG(p_blackboard.is_null(), nullptr, "BehaviorTree: Instantiation failed - blackboard can't be null.");
 	Node *scene_root = p_custom_scene_root ? p_custom_scene_root : p_instance_owner->get_owner();
 	ERR_FAIL_NULL_V_MSG(scene_root, nullptr, "BehaviorTree: Instantiation failed - unable to establish scene root. This is likely due to the instance owner not being owned by a scene node and custom_scene_root being null.");
-	Ref<BTTask> root_copy = root_task->clone();
+	Ref<BTTask> prototype = get_runtime_prototype();
+	ERR_FAIL_COND_V_MSG(prototype.is_null(), nullptr, "BehaviorTree: Instantiation failed - root task is disabled.");
+	Ref<BTTask> root_copy = prototype->clone();
 	root_copy->initialize(p_agent, p_blackboard, scene_root);
-	return BTInstance::create(root_copy, get_path(), p_instance_owner);
+	return _create_instance(root_copy, p_instance_owner);
+}
+
+void BehaviorTree::instantiate_async(Node *p_agent, const Ref<Blackboard> &p_blackboard, Node *p_instance_owner, const Callable &p_callback, Node *p_custom_scene_root) {
+	ERR_FAIL_COND_MSG(root_task.is_null(), "BehaviorTree: Instantiation failed - BT has no valid root task.");
+	ERR_FAIL_NULL_MSG(p_agent, "BehaviorTree: Instantiation failed - agent can't be null.");
+	ERR_FAIL_NULL_MSG(p_instance_owner, "BehaviorTree: Instantiation failed -- instance owner can't be null.");
+	ERR_FAIL_COND_MSG(p_blackboard.is_null(), "BehaviorTree: Instantiation failed - blackboard can't be null.");
+	ERR_FAIL_COND_MSG(!p_callback.is_valid(), "BehaviorTree: Instantiation failed - callback is not valid.");
+	Node *scene_root = p_custom_scene_root ? p_custom_scene_root : p_instance_owner->get_owner();
+	ERR_FAIL_NULL_MSG(scene_root, "BehaviorTree: Instantiation failed - unable to establish scene root. This is likely due to the instance owner not being owned by a scene node and custom_scene_root being null.");
+	// * The prototype (and the clone plans of its tasks) are created on the main thread.
+	Ref<BTTask> prototype = get_runtime_prototype();
+	ERR_FAIL_COND_MSG(prototype.is_null(), "BehaviorTree: Instantiation failed - root task is disabled.");
+
+	_wait_for_async_tasks(false);
+	if (prototype_has_scripts) {
+		// * Script instances must be created on the main thread. The result is still delivered deferred.
+		Ref<BTTask> root_copy = prototype->clone();
+		callable_mp(this, &BehaviorTree::_instantiate_async_finish).call_deferred(root_copy, uint64_t(p_agent->get_instance_id()), p_blackboard, uint64_t(p_instance_owner->get_instance_id()), uint64_t(scene_root->get_instance_id()), p_callback);
+		return;
+	}
+	Callable run = callable_mp(this, &BehaviorTree::_instantiate_async_run).bind(prototype, uint64_t(p_agent->get_instance_id()), p_blackboard, uint64_t(p_instance_owner->get_instance_id()), uint64_t(scene_root->get_instance_id()), p_callback);
+	async_tasks.push_back(WorkerThreadPool::get_singleton()->add_task(run, false, "BehaviorTree::instantiate_async"));
+}
+
+void BehaviorTree::_instantiate_async_run(const Ref<BTTask> &p_prototype, uint64_t p_agent_id, const Ref<Blackboard> &p_blackboard, uint64_t p_owner_id, uint64_t p_scene_root_id, const Callable &p_callback) {
+	// * Runs on a worker thread: cloning doesn't touch the scene tree.
+	Ref<BTTask> root_copy = p_prototype->clone();
+	callable_mp(this, &BehaviorTree::_instantiate_async_finish).call_deferred(root_copy, p_agent_id, p_blackboard, p_owner_id, p_scene_root_id, p_callback);
+}
+
+void BehaviorTree::_instantiate_async_finish(const Ref<BTTask> &p_root_copy, uint64_t p_agent_id, const Ref<Blackboard> &p_blackboard, uint64_t p_owner_id, uint64_t p_scene_root_id, const Callable &p_callback) {
+	_wait_for_async_tasks(false);
+
+	// * The nodes may have been freed while the tree was being cloned.
+	Node *agent = Object::cast_to<Node>(OBJECT_DB_GET_INSTANCE(p_agent_id));
+	Node *owner = Object::cast_to<Node>(OBJECT_DB_GET_INSTANCE(p_owner_id));
+	Node *scene_root = Object::cast_to<Node>(OBJECT_DB_GET_INSTANCE(p_scene_root_id));
+	if (agent == nullptr || owner == nullptr || scene_root == nullptr) {
+		ERR_PRINT("BehaviorTree: Instantiation failed - agent, instance owner or scene root was freed before the tree was ready.");
+		p_callback.call(Variant());
+		return;
+	}
+
+	// * Node-touching steps, such as _setup(), run on the main thread.
+	p_root_copy->initialize(agent, p_blackboard, scene_root);
+	p_callback.call(_create_instance(p_root_copy, owner));
+}
+
+void BehaviorTree::_wait_for_async_tasks(bool p_all) {
+	uint32_t i = 0;
+	while (i < async_tasks.size()) {
+		if (p_all || WorkerThreadPool::get_singleton()->is_task_completed(async_tasks[i])) {
+			WorkerThreadPool::get_singleton()->wait_for_task_completion(async_tasks[i]);
+			async_tasks.remove_at_unordered(i);
+		} else {
+			i += 1;
+		}
+	}
 }
 
 void BehaviorTree::emit_branch_changed(const Ref<BTTask> &p_branch) {
@@ -100,13 +230,13 @@ void BehaviorTree::_plan_changed() {
 
 void BehaviorTree::_set_editor_behavior_tree_hint() {
 	if (root_task.is_valid()) {
-		root_task->data.behavior_tree_id = this->get_instance_id();
+		root_task->_get_cold()->behavior_tree_id = this->get_instance_id();
 	}
 }
 
 void BehaviorTree::_unset_editor_behavior_tree_hint() {
-	if (root_task.is_valid()) {
-		root_task->data.behavior_tree_id = ObjectID();
+	if (root_task.is_valid() && root_task->data.cold) {
+		root_task->data.cold->behavior_tree_id = ObjectID();
 	}
 }
 
@@ -117,14 +247,18 @@ void BehaviorTree::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_description"), &BehaviorTree::get_description);
 	ClassDB::bind_method(D_METHOD("set_blackboard_plan", "plan"), &BehaviorTree::set_blackboard_plan);
 	ClassDB::bind_method(D_METHOD("get_blackboard_plan"), &BehaviorTree::get_blackboard_plan);
+	ClassDB::bind_method(D_METHOD("set_thread_safe", "thread_safe"), &BehaviorTree::set_thread_safe);
+	ClassDB::bind_method(D_METHOD("is_thread_safe"), &BehaviorTree::is_thread_safe);
 	ClassDB::bind_method(D_METHOD("set_root_task", "task"), &BehaviorTree::set_root_task);
 	ClassDB::bind_method(D_METHOD("get_root_task"), &BehaviorTree::get_root_task);
 	ClassDB::bind_method(D_METHOD("clone"), &BehaviorTree::clone);
 	ClassDB::bind_method(D_METHOD("copy_other", "other"), &BehaviorTree::copy_other);
 	ClassDB::bind_method(D_METHOD("instantiate", "agent", "blackboard", "instance_owner", "custom_scene_root"), &BehaviorTree::instantiate, DEFVAL(Variant()));
+	ClassDB::bind_method(D_METHOD("instantiate_async", "agent", "blackboard", "instance_owner", "callback", "custom_scene_root"), &BehaviorTree::instantiate_async, DEFVAL(Variant()));
 
 	ADD_PROPERTY(PropertyInfo(Variant::STRING, "description", PROPERTY_HINT_MULTILINE_TEXT), "set_description", "get_description");
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "blackboard_plan", PROPERTY_HINT_RESOURCE_TYPE, "BlackboardPlan", PROPERTY_USAGE_DEFAULT | PROPERTY_USAGE_EDITOR_INSTANTIATE_OBJECT), "set_blackboard_plan", "get_blackboard_plan");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "thread_safe"), "set_thread_safe", "is_thread_safe");
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "root_task", PROPERTY_HINT_RESOURCE_TYPE, "BTTask", PROPERTY_USAGE_NO_EDITOR | PROPERTY_USAGE_INTERNAL), "set_root_task", "get_root_task");
 
 	ADD_SIGNAL(MethodInfo("plan_changed"));
@@ -135,6 +269,8 @@ BehaviorTree::BehaviorTree() {
 }
 
 BehaviorTree::~BehaviorTree() {
+	_wait_for_async_tasks(true);
+	_invalidate_runtime_prototype();
 	if (Engine::get_singleton()->is_editor_hint() && blackboard_plan.is_valid() &&
 			blackboard_plan->is_connected(LW_NAME(changed), callable_mp(this, &BehaviorTree::_plan_changed))) {
 		blackboard_plan->disconnect(LW_NAME(changed), callable_mp(this, &BehaviorTree::_plan_changed));
@@ -27,13 +27,28 @@ using namespace godot;
 
 class BehaviorTree : public Resource {
 	GDCLASS(BehaviorTree, Resource);
+	friend class BTInstancePool;
 
 private:
 	String description;
 	Ref<BlackboardPlan> blackboard_plan;
 	Ref<BTTask> root_task;
+	bool thread_safe = false;
+	mutable Ref<BTTask> runtime_prototype;
+	mutable LocalVector<Ref<BTTask>> prototype_sources; // Tasks watched for changes, see get_runtime_prototype().
+	uint64_t prototype_generation = 0; // Incremented whenever the runtime prototype is reset or thread_safe changes.
+	mutable bool prototype_has_scripts = false; // Such trees are cloned on the main thread, see instantiate_async().
+	mutable BTCompiledTree::Layout runtime_layout; // Compiled structure of the instances, shared between them.
+	LocalVector<int64_t> async_tasks; // WorkerThreadPool tasks started by instantiate_async().
 
 	void _plan_changed();
+	void _invalidate_runtime_prototype();
+	static void _mark_prototype(BTTask *p_task);
+	Ref<BTInstance> _create_instance(const Ref<BTTask> &p_root_copy, Node *p_instance_owner) const;
+
+	void _instantiate_async_run(const Ref<BTTask> &p_prototype, uint64_t p_agent_id, const Ref<Blackboard> &p_blackboard, uint64_t p_owner_id, uint64_t p_scene_root_id, const Callable &p_callback);
+	void _instantiate_async_finish(const Ref<BTTask> &p_root_copy, uint64_t p_agent_id, const Ref<Blackboard> &p_blackboard, uint64_t p_owner_id, uint64_t p_scene_root_id, const Callable &p_callback);
+	void _wait_for_async_tasks(bool p_all);
 
 #ifdef TOOLS_ENABLED
 	void _set_editor_behavior_tree_hint();
@@ -58,13 +73,26 @@ public:
 	void set_blackboard_plan(const Ref<BlackboardPlan> &p_plan);
 	Ref<BlackboardPlan> get_blackboard_plan() const { return blackboard_plan; }
 
+	void set_thread_safe(bool p_thread_safe);
+	bool is_thread_safe() const { return thread_safe; }
+
 	void set_root_task(const Ref<BTTask> &p_value);
 	Ref<BTTask> get_root_task() const { return root_task; }
 
+	// Returns the task hierarchy that runtime instances are cloned from. Outside of the editor,
+	// this is a cached copy of the root task without disabled tasks and comments, created on first use.
+	// It's reset whenever any of the source tasks emits "changed", as well as by set_root_task() and copy_other().
+	Ref<BTTask> get_runtime_prototype() const;
+
 	Ref<BehaviorTree> clone() const;
 	void copy_other(const Ref<BehaviorTree> &p_other);
 	Ref<BTInstance> instantiate(Node *p_agent, const Ref<Blackboard> &p_blackboard, Node *p_instance_owner, Node *p_custom_scene_root = nullptr) const;
 
+	// Clones the task hierarchy on a worker thread, then initializes it on the main thread
+	// and calls p_callback with the new BTInstance (or null, if any of the nodes were freed meanwhile).
+	// Trees with scripted tasks are cloned on the main thread, as creating script instances isn't thread-safe.
+	void instantiate_async(Node *p_agent, const Ref<Blackboard> &p_blackboard, Node *p_instance_owner, const Callable &p_callback, Node *p_custom_scene_root = nullptr);
+
 	void emit_branch_changed(const Ref<BTTask> &p_branch);
 
 	BehaviorTree();
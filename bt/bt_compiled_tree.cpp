@@ -0,0 +1,220 @@
+/**
+ * bt_compiled_tree.cpp
+ * =============================================================================
+ * Copyright (c) 2023-present Serhii Snitsaruk and the LimboAI contributors.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#include "bt_compiled_tree.h"
+
+void BTCompiledTree::Layout::_unref() {
+	if (data && data->refcount.unref()) {
+		memdelete(data);
+	}
+	data = nullptr;
+}
+
+void BTCompiledTree::Layout::operator=(const Layout &p_other) {
+	if (this == &p_other || data == p_other.data) {
+		return;
+	}
+	_unref();
+	if (p_other.data && p_other.data->refcount.ref()) {
+		data = p_other.data;
+	}
+}
+
+BTCompiledTree::Layout::Layout(const Layout &p_other) {
+	if (p_other.data && p_other.data->refcount.ref()) {
+		data = p_other.data;
+	}
+}
+
+void BTCompiledTree::_collect_tasks(BTTask *p_task) {
+	if (p_task->data.compiled_tree && p_task->data.compiled_tree != this) {
+		// Still referenced by another layout, e.g. a branch moved between instances.
+		p_task->data.compiled_tree->mark_dirty();
+	}
+	p_task->data.compiled_tree = this;
+	p_task->data.compiled_index = tasks.size();
+	tasks.push_back(p_task);
+
+	for (int i = 0; i < p_task->data.children.size(); i++) {
+		_collect_tasks(p_task->data.children[i].ptr());
+	}
+}
+
+bool BTCompiledTree::_matches(const Layout &p_layout) const {
+	// * In pre-order, the child counts alone determine the structure.
+	if (p_layout.size() != (int)tasks.size()) {
+		return false;
+	}
+	const Node *nodes = p_layout.ptr();
+	for (uint32_t i = 0; i < tasks.size(); i++) {
+		if (nodes[i].child_count != tasks[i]->data.children.size()) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void BTCompiledTree::_build_layout() {
+	Layout::Data *new_data = memnew(Layout::Data);
+	new_data->refcount.init();
+	LocalVector<Node> &nodes = new_data->nodes;
+	nodes.resize(tasks.size());
+	for (uint32_t i = 0; i < tasks.size(); i++) {
+		nodes[i].parent = i == 0 ? -1 : tasks[i]->data.parent->data.compiled_index;
+		nodes[i].child_count = tasks[i]->data.children.size();
+		nodes[i].subtree_end = i + 1;
+	}
+	// * A subtree ends where its last descendant's subtree ends.
+	for (int i = (int)nodes.size() - 1; i > 0; i--) {
+		Node &parent = nodes[nodes[i].parent];
+		parent.subtree_end = MAX(parent.subtree_end, nodes[i].subtree_end);
+	}
+	layout._unref();
+	layout.data = new_data;
+}
+
+void BTCompiledTree::compile(BTTask *p_root, const Layout &p_shared) {
+	clear();
+	ERR_FAIL_NULL(p_root);
+	_collect_tasks(p_root);
+	if (p_shared.is_valid() && _matches(p_shared)) {
+		layout = p_shared;
+	} else {
+		_build_layout();
+	}
+
+	for (uint32_t i = 0; i < tasks.size(); i++) {
+		if (tasks[i]->data.suspended) {
+			num_suspended += 1;
+		}
+	}
+}
+
+int BTCompiledTree::find_resume_index(int p_from) const {
+	ERR_FAIL_COND_V(dirty, -1);
+	ERR_FAIL_INDEX_V(p_from, (int)tasks.size(), -1);
+	const Node *nodes = layout.ptr();
+	// Descend through pass-through tasks along the running path.
+	int idx = p_from;
+	while (tasks[idx]->data.status == BT::RUNNING && tasks[idx]->data.pass_through) {
+		int running_child = -1;
+		for (int i = idx + 1; i < nodes[idx].subtree_end; i = nodes[i].subtree_end) {
+			if (tasks[i]->data.status == BT::RUNNING) {
+				running_child = i;
+				break;
+			}
+		}
+		if (running_child == -1) {
+			break;
+		}
+		idx = running_child;
+	}
+	return idx;
+}
+
+bool BTCompiledTree::is_running_path(int p_index) const {
+	const Node *nodes = layout.ptr();
+	for (int i = p_index; i != -1; i = nodes[i].parent) {
+		if (tasks[i]->data.status != BT::RUNNING) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void BTCompiledTree::add_elapsed_to_ancestors(int p_index, double p_delta) {
+	const Node *nodes = layout.ptr();
+	for (int i = nodes[p_index].parent; i != -1; i = nodes[i].parent) {
+		tasks[i]->data.elapsed += p_delta;
+	}
+}
+
+void BTCompiledTree::add_elapsed_to_path(int p_index, int p_end, double p_delta) {
+	const Node *nodes = layout.ptr();
+	for (int i = p_index; i != p_end && i != -1; i = nodes[i].parent) {
+		tasks[i]->data.elapsed += p_delta;
+	}
+}
+
+int BTCompiledTree::find_sleeping_index(int p_from) const {
+	if (num_suspended == 0 || dirty) {
+		return -1;
+	}
+	const int idx = find_resume_index(p_from);
+	return (idx != -1 && tasks[idx]->data.status == BT::RUNNING && tasks[idx]->data.suspended) ? idx : -1;
+}
+
+void BTCompiledTree::notify_suspended(bool p_suspended) {
+	if (p_suspended) {
+		num_suspended += 1;
+		return;
+	}
+	num_suspended -= 1;
+	_wake();
+}
+
+void BTCompiledTree::_wake() {
+	if (asleep) {
+		asleep = false;
+		if (wake_callback) {
+			wake_callback(wake_userdata);
+		}
+	}
+}
+
+bool BTCompiledTree::update_asleep() {
+	asleep = !tasks.is_empty() && tasks[0]->data.status == BT::RUNNING && find_sleeping_index(0) != -1;
+	return asleep;
+}
+
+void BTCompiledTree::set_wake_callback(WakeCallback p_callback, void *p_userdata) {
+	wake_callback = p_callback;
+	wake_userdata = p_userdata;
+}
+
+void BTCompiledTree::_detach_tasks() {
+	for (uint32_t i = 0; i < tasks.size(); i++) {
+		BTTask *task = tasks[i];
+		if (task->data.compiled_tree == this) {
+			task->data.compiled_tree = nullptr;
+			task->data.compiled_index = -1;
+		}
+	}
+}
+
+void BTCompiledTree::clear() {
+	// Once dirty, tasks are already detached and may no longer exist.
+	if (!dirty) {
+		_detach_tasks();
+	}
+	tasks.clear();
+	layout._unref();
+	dirty = false;
+	reshaped = false;
+	num_suspended = 0;
+	asleep = false;
+}
+
+void BTCompiledTree::mark_dirty(bool p_expansion) {
+	if (dirty) {
+		return;
+	}
+	_detach_tasks();
+	dirty = true;
+	reshaped = !p_expansion;
+	// * Detached tasks no longer report to this tree; suspended ones are counted again by compile().
+	num_suspended = 0;
+	_wake();
+}
+
+BTCompiledTree::~BTCompiledTree() {
+	clear();
+}
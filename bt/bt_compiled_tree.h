@@ -0,0 +1,131 @@
+/**
+ * bt_compiled_tree.h
+ * =============================================================================
+ * Copyright (c) 2023-present Serhii Snitsaruk and the LimboAI contributors.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#ifndef BT_COMPILED_TREE_H
+#define BT_COMPILED_TREE_H
+
+#include "tasks/bt_task.h"
+
+#ifdef LIMBOAI_MODULE
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+#endif // LIMBOAI_MODULE
+
+#ifdef LIMBOAI_GDEXTENSION
+#include <godot_cpp/templates/local_vector.hpp>
+#include <godot_cpp/templates/safe_refcount.hpp>
+using namespace godot;
+#endif // LIMBOAI_GDEXTENSION
+
+// Flat depth-first layout of an instantiated behavior tree.
+// Tasks are stored in pre-order, so the descendants of a task at `index` occupy
+// the range [index + 1, subtree_end), and its children are found by jumping from
+// one child's subtree_end to the next.
+// The structure (Layout) is built once per BehaviorTree and shared by its instances,
+// each of which only keeps its own array of task pointers.
+// Execution still recurses through the task hierarchy and the virtual _tick() of each task;
+// the layout serves abort(), resuming at the running task and suspension.
+// A task belongs to at most one layout: compiling it elsewhere marks the previous one dirty.
+class BTCompiledTree {
+public:
+	struct Node {
+		int parent = -1;
+		int subtree_end = 0;
+		int child_count = 0;
+	};
+
+	// Immutable, reference-counted structure of a compiled tree.
+	class Layout {
+		friend class BTCompiledTree;
+
+		struct Data {
+			SafeRefCount refcount;
+			LocalVector<Node> nodes;
+		};
+		Data *data = nullptr;
+
+		void _unref();
+
+	public:
+		_FORCE_INLINE_ bool is_valid() const { return data != nullptr; }
+		_FORCE_INLINE_ int size() const { return data ? (int)data->nodes.size() : 0; }
+		_FORCE_INLINE_ const Node *ptr() const { return data->nodes.ptr(); }
+
+		void operator=(const Layout &p_other);
+		Layout(const Layout &p_other);
+		Layout() = default;
+		~Layout() { _unref(); }
+	};
+
+	typedef void (*WakeCallback)(void *p_userdata);
+
+private:
+	Layout layout;
+	LocalVector<BTTask *> tasks;
+	bool dirty = false;
+	bool reshaped = false; // Hierarchy no longer matches the one the instance was created with, see mark_dirty().
+
+	// Suspension, see BTTask::suspend().
+	int num_suspended = 0;
+	bool asleep = false;
+	WakeCallback wake_callback = nullptr;
+	void *wake_userdata = nullptr;
+
+	void _collect_tasks(BTTask *p_task);
+	bool _matches(const Layout &p_layout) const;
+	void _build_layout();
+	void _detach_tasks();
+	void _wake();
+
+public:
+	// Compiles the hierarchy under p_root. If p_shared matches it, its structure is reused
+	// instead of building a new one. See get_layout().
+	void compile(BTTask *p_root, const Layout &p_shared = Layout());
+	void clear();
+
+	// Called when the task hierarchy changes after compilation. Tasks are detached
+	// right away, so they fall back to the regular hierarchy until recompiled.
+	// p_expansion is set when on-demand parts of the prototype are added (see BTSubtree::lazy),
+	// which don't make the hierarchy differ from the one a fresh instance would reach.
+	void mark_dirty(bool p_expansion = false);
+	_FORCE_INLINE_ bool is_dirty() const { return dirty; }
+	_FORCE_INLINE_ bool is_reshaped() const { return reshaped; }
+
+	_FORCE_INLINE_ const Layout &get_layout() const { return layout; }
+	_FORCE_INLINE_ int size() const { return tasks.size(); }
+	_FORCE_INLINE_ const Node *ptr() const { return layout.ptr(); }
+	_FORCE_INLINE_ BTTask *const *tasks_ptr() const { return tasks.ptr(); }
+	_FORCE_INLINE_ const Node &get_node(int p_index) const { return layout.ptr()[p_index]; }
+	_FORCE_INLINE_ BTTask *get_task(int p_index) const { return tasks[p_index]; }
+
+	// Helpers for resuming execution at a running task, see BTInstance::update().
+	int find_resume_index(int p_from) const;
+	bool is_running_path(int p_index) const;
+	void add_elapsed_to_ancestors(int p_index, double p_delta);
+	// Adds p_delta to the task at p_index and its ancestors, stopping before p_end (or at the root, if -1).
+	void add_elapsed_to_path(int p_index, int p_end, double p_delta);
+
+	// The tree is asleep while its running path, descending through pass-through tasks,
+	// ends at a suspended task. Updated by BTInstance after each update; resuming any task
+	// wakes the tree and calls the wake callback.
+	void notify_suspended(bool p_suspended);
+	_FORCE_INLINE_ bool has_suspended() const { return num_suspended > 0; }
+	// Returns the index of the suspended task that the running path from p_from ends at, or -1.
+	int find_sleeping_index(int p_from) const;
+	bool update_asleep();
+	_FORCE_INLINE_ bool is_asleep() const { return asleep; }
+	void set_wake_callback(WakeCallback p_callback, void *p_userdata);
+
+	BTCompiledTree() = default;
+	~BTCompiledTree();
+};
+
+#endif // BT_COMPILED_TREE_H
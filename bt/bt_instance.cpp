@@ -15,14 +15,17 @@
 #include "../compat/performance.h"
 #include "../editor/debugger/limbo_debugger.h"
 #include "../util/limbo_string_names.h"
+#include "../util/limbo_tick_server.h"
 
 #ifdef LIMBOAI_MODULE
+#include "core/object/script_language.h"
 #include "core/os/time.h"
 #include "main/performance.h"
 #endif
 
 #ifdef LIMBOAI_GDEXTENSION
 #include <godot_cpp/classes/performance.hpp>
+#include <godot_cpp/classes/script.hpp>
 #include <godot_cpp/classes/time.hpp>
 #endif
 
@@ -30,27 +33,167 @@ Node *BTInstance::get_owner_node() const {
 	return owner_node_id ? Object::cast_to<Node>(OBJECT_DB_GET_INSTANCE(owner_node_id)) : nullptr;
 }
 
-Ref<BTInstance> BTInstance::create(Ref<BTTask> p_root_task, String p_source_bt_path, Node *p_owner_node) {
+Ref<BTInstance> BTInstance::create(Ref<BTTask> p_root_task, String p_source_bt_path, Node *p_owner_node, bool p_thread_safe, BTCompiledTree::Layout *r_shared_layout) {
 	ERR_FAIL_COND_V(p_root_task.is_null(), nullptr);
 	ERR_FAIL_NULL_V(p_owner_node, nullptr);
 	Ref<BTInstance> inst;
 	inst.instantiate();
 	inst->root_task = p_root_task;
+	if (r_shared_layout) {
+		inst->compiled_tree.compile(p_root_task.ptr(), *r_shared_layout);
+		if (!r_shared_layout->is_valid()) {
+			*r_shared_layout = inst->compiled_tree.get_layout();
+		}
+	} else {
+		inst->compiled_tree.compile(p_root_task.ptr());
+	}
+	inst->compiled_tree.set_wake_callback(&BTInstance::_on_wake, inst.ptr());
 	inst->owner_node_id = p_owner_node->get_instance_id();
 	inst->source_bt_path = p_source_bt_path;
+	inst->thread_safe = p_thread_safe && inst->_check_thread_safe();
+	inst->reusable = inst->_check_reusable();
+	inst->_update_scopes();
 	return inst;
 }
 
+bool BTInstance::_check_thread_safe() const {
+	for (int i = 0; i < compiled_tree.size(); i++) {
+		const BTTask *task = compiled_tree.get_task(i);
+		if (!task->is_thread_safe()) {
+			WARN_PRINT(vformat("BTInstance: %s is not thread-safe, the tree \"%s\" will be updated on the main thread.", task->get_class(), source_bt_path));
+			return false;
+		}
+	}
+	return true;
+}
+
+bool BTInstance::_check_reusable() const {
+	for (int i = 0; i < compiled_tree.size(); i++) {
+		if (!compiled_tree.get_task(i)->is_reusable()) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void BTInstance::_update_scopes() {
+	_release_scopes();
+	for (int i = 0; i < compiled_tree.size(); i++) {
+		const Ref<Blackboard> &bb = compiled_tree.get_task(i)->data.blackboard;
+		if (bb.is_valid() && scopes.find(bb) == -1) {
+			scopes.push_back(bb);
+			bb->add_instance();
+		}
+	}
+}
+
+void BTInstance::_release_scopes() {
+	for (const Ref<Blackboard> &bb : scopes) {
+		bb->remove_instance();
+	}
+	scopes.clear();
+}
+
+bool BTInstance::is_thread_safe() const {
+	if (!thread_safe || scopes.is_empty() || scopes[0]->get_parent().is_valid()) {
+		return false;
+	}
+	// * Nested scopes (see BTNewScope) are private to the instance, unless their variables are shared,
+	// or the same blackboard was passed to another instance.
+	for (const Ref<Blackboard> &bb : scopes) {
+		if (bb->is_shared() || bb->get_instance_count() > 1) {
+			return false;
+		}
+	}
+	return true;
+}
+
 BT::Status BTInstance::update(double p_delta) {
 	ERR_FAIL_COND_V(!root_task.is_valid(), BT::FRESH);
+	const Ref<BTInstance> keep_alive{ this }; // keep instance alive until update is finished
+	update_threaded(p_delta);
+	emit_updated();
+	return last_status;
+}
+
+void BTInstance::emit_updated() {
+	if (update_callback) {
+		update_callback(this, last_status, update_callback_userdata);
+	}
+#ifdef DEBUG_ENABLED
+	if (unlikely(debugger_callback)) {
+		debugger_callback(this, last_status, nullptr);
+	}
+#endif
+	if (updated_signal_mode == SIGNAL_ON_STATUS_CHANGE && last_status == previous_status) {
+		return;
+	}
+	// * Skip packing the arguments if nobody is listening.
+	if (has_connections(LW_NAME(updated))) {
+		emit_signal(LW_NAME(updated), last_status);
+	}
+}
+
+void BTInstance::_on_wake(void *p_userdata) {
+	static_cast<BTInstance *>(p_userdata)->emit_signal(LW_NAME(resumed));
+}
+
+void BTInstance::add_sleep_time(double p_seconds) {
+	ERR_FAIL_COND(!root_task.is_valid());
+	if (compiled_tree.is_dirty() || compiled_tree.size() == 0 || root_task->get_status() != BT::RUNNING) {
+		return;
+	}
+	compiled_tree.add_elapsed_to_path(compiled_tree.find_resume_index(0), -1, p_seconds);
+}
+
+void BTInstance::set_update_callback(UpdateCallback p_callback, void *p_userdata) {
+	update_callback = p_callback;
+	update_callback_userdata = p_userdata;
+}
+
+BT::Status BTInstance::update_threaded(double p_delta) {
+	ERR_FAIL_COND_V(!root_task.is_valid(), BT::FRESH);
+
+	if (compiled_tree.is_asleep()) {
+		// * Nothing to execute until a suspended task is resumed, but time still passes for the running path.
+		compiled_tree.add_elapsed_to_path(compiled_tree.find_sleeping_index(0), -1, p_delta);
+		previous_status = last_status;
+		return last_status;
+	}
 
 #ifdef DEBUG_ENABLED
 	double start = Time::get_singleton()->get_ticks_usec();
 #endif
 
 	const Ref<BTInstance> keep_alive{ this }; // keep instance alive until update is finished
-	last_status = root_task->execute(p_delta);
-	emit_signal(LW_NAME(updated), last_status);
+	previous_status = last_status;
+	if (unlikely(compiled_tree.is_dirty())) {
+		// Task hierarchy was modified at runtime.
+		const bool reshaped = compiled_tree.is_reshaped();
+		compiled_tree.compile(root_task.ptr());
+		_update_scopes();
+		resume_index = -1;
+		// * Lazily added subtrees stay in place when recycled, but their tasks must be reusable as well.
+		reusable = !reshaped && reusable && _check_reusable();
+	}
+
+	if (resume_at_running_task) {
+		if (resume_index > 0 && compiled_tree.is_running_path(resume_index)) {
+			last_status = _resume(p_delta);
+		} else {
+			last_status = root_task->execute(p_delta);
+			resume_index = 0;
+		}
+		// Look for a deeper running task, starting where the active path is known to be intact.
+		if (last_status == BT::RUNNING && !compiled_tree.is_dirty()) {
+			resume_index = compiled_tree.find_resume_index(resume_index);
+		} else {
+			resume_index = -1;
+		}
+	} else {
+		last_status = root_task->execute(p_delta);
+	}
+	compiled_tree.update_asleep();
 
 #ifdef DEBUG_ENABLED
 	double end = Time::get_singleton()->get_ticks_usec();
@@ -60,6 +203,117 @@ BT::Status BTInstance::update(double p_delta) {
 	return last_status;
 }
 
+BT::Status BTInstance::_resume(double p_delta) {
+	// Keep the task alive in case the hierarchy is modified during its execution.
+	const Ref<BTTask> task{ compiled_tree.get_task(resume_index) };
+	BT::Status status = task->execute(p_delta);
+	if (status == BT::RUNNING && !compiled_tree.is_dirty()) {
+		// Pass-through ancestors would return RUNNING as well, just accumulating elapsed time.
+		compiled_tree.add_elapsed_to_ancestors(resume_index, p_delta);
+		return BT::RUNNING;
+	}
+
+	// Walk back up: execute from the root, with the task reporting the status it already returned.
+	task->data.resume_latched = true;
+	BT::Status root_status = root_task->execute(p_delta);
+	task->data.resume_latched = false;
+	resume_index = 0; // The active path may have changed.
+	return root_status;
+}
+
+struct BTInstanceBatch {
+	BTInstance **instances = nullptr;
+	double delta = 0.0;
+};
+
+void BTInstance::_update_batch_task(void *p_userdata, uint32_t p_index) {
+	const BTInstanceBatch *batch = static_cast<BTInstanceBatch *>(p_userdata);
+	batch->instances[p_index]->update_threaded(batch->delta);
+}
+
+void BTInstance::update_batch(const TypedArray<BTInstance> &p_instances, double p_delta) {
+	LocalVector<BTInstance *> threaded;
+	for (int i = 0; i < p_instances.size(); i++) {
+		Ref<BTInstance> inst = p_instances[i];
+		ERR_CONTINUE(inst.is_null() || !inst->is_instance_valid());
+		if (inst->is_thread_safe()) {
+			threaded.push_back(inst.ptr());
+		}
+	}
+
+	// * The array holds references, so the instances stay alive during the batch.
+	BTInstanceBatch batch;
+	batch.instances = threaded.ptr();
+	batch.delta = p_delta;
+	LimboTickServer::get_singleton()->run_parallel(&BTInstance::_update_batch_task, &batch, threaded.size());
+
+	// * Signals are emitted on the calling thread, in the order of the array.
+	uint32_t next_threaded = 0;
+	for (int i = 0; i < p_instances.size(); i++) {
+		Ref<BTInstance> inst = p_instances[i];
+		if (inst.is_null() || !inst->is_instance_valid()) {
+			continue;
+		}
+		if (next_threaded < threaded.size() && threaded[next_threaded] == inst.ptr()) {
+			next_threaded += 1;
+			inst->emit_updated();
+		} else {
+			inst->update(p_delta);
+		}
+	}
+}
+
+void BTInstance::_recycle() {
+	ERR_FAIL_COND(root_task.is_null());
+	root_task->abort();
+	unregister_with_debugger();
+#ifdef DEBUG_ENABLED
+	set_monitor_performance(false);
+	monitor_id = StringName();
+#endif // DEBUG_ENABLED
+	update_callback = nullptr;
+	update_callback_userdata = nullptr;
+	_release_scopes();
+	last_status = BT::FRESH;
+	previous_status = BT::FRESH;
+	resume_index = -1;
+	owner_node_id = 0;
+	pooled = true;
+	// * Connections belong to the previous owner.
+	_disconnect_all(LW_NAME(updated));
+	_disconnect_all(LW_NAME(resumed));
+	_disconnect_all(LW_NAME(freed));
+}
+
+void BTInstance::_disconnect_all(const StringName &p_signal) {
+#ifdef LIMBOAI_MODULE
+	List<Connection> connections;
+	get_signal_connection_list(p_signal, &connections);
+	for (const Connection &c : connections) {
+		disconnect(p_signal, c.callable);
+	}
+#elif LIMBOAI_GDEXTENSION
+	TypedArray<Dictionary> connections = get_signal_connection_list(p_signal);
+	for (int i = 0; i < connections.size(); i++) {
+		Dictionary c = connections[i];
+		disconnect(p_signal, c["callable"]);
+	}
+#endif
+}
+
+void BTInstance::_rebind(Node *p_agent, const Ref<Blackboard> &p_blackboard, Node *p_owner_node, Node *p_scene_root) {
+	ERR_FAIL_COND(root_task.is_null());
+	root_task->initialize(p_agent, p_blackboard, p_scene_root);
+	_update_scopes();
+	owner_node_id = p_owner_node->get_instance_id();
+	pooled = false;
+}
+
+void BTInstance::set_resume_at_running_task(bool p_enable) {
+	resume_at_running_task = p_enable;
+	resume_index = -1;
+}
+
 void BTInstance::set_monitor_performance(bool p_monitor) {
 #ifdef DEBUG_ENABLED
 	monitor_performance = p_monitor;
@@ -139,22 +393,39 @@ void BTInstance::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("is_instance_valid"), &BTInstance::is_instance_valid);
 
+	ClassDB::bind_method(D_METHOD("set_resume_at_running_task", "enable"), &BTInstance::set_resume_at_running_task);
+	ClassDB::bind_method(D_METHOD("get_resume_at_running_task"), &BTInstance::get_resume_at_running_task);
+
 	ClassDB::bind_method(D_METHOD("set_monitor_performance", "monitor"), &BTInstance::set_monitor_performance);
 	ClassDB::bind_method(D_METHOD("get_monitor_performance"), &BTInstance::get_monitor_performance);
 
 	ClassDB::bind_method(D_METHOD("update", "delta"), &BTInstance::update);
+	ClassDB::bind_method(D_METHOD("is_thread_safe"), &BTInstance::is_thread_safe);
+	ClassDB::bind_method(D_METHOD("is_suspended"), &BTInstance::is_suspended);
+	ClassDB::bind_method(D_METHOD("add_sleep_time", "seconds"), &BTInstance::add_sleep_time);
+	ClassDB::bind_method(D_METHOD("set_updated_signal_mode", "mode"), &BTInstance::set_updated_signal_mode);
+	ClassDB::bind_method(D_METHOD("get_updated_signal_mode"), &BTInstance::get_updated_signal_mode);
+	ClassDB::bind_static_method("BTInstance", D_METHOD("update_batch", "instances", "delta"), &BTInstance::update_batch);
 
 	ClassDB::bind_method(D_METHOD("register_with_debugger"), &BTInstance::register_with_debugger);
 	ClassDB::bind_method(D_METHOD("unregister_with_debugger"), &BTInstance::unregister_with_debugger);
 
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "resume_at_running_task"), "set_resume_at_running_task", "get_resume_at_running_task");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "monitor_performance"), "set_monitor_performance", "get_monitor_performance");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "updated_signal_mode", PROPERTY_HINT_ENUM, "Always,On Status Change"), "set_updated_signal_mode", "get_updated_signal_mode");
+
+	BIND_ENUM_CONSTANT(SIGNAL_ALWAYS);
+	BIND_ENUM_CONSTANT(SIGNAL_ON_STATUS_CHANGE);
 
 	ADD_SIGNAL(MethodInfo("updated", PropertyInfo(Variant::INT, "status")));
 	ADD_SIGNAL(MethodInfo("freed"));
+	ADD_SIGNAL(MethodInfo("resumed"));
 }
 
 BTInstance::~BTInstance() {
 	emit_signal(LW_NAME(freed));
+	_release_scopes();
+	compiled_tree.clear();
 #ifdef DEBUG_ENABLED
 	_remove_custom_monitor();
 	unregister_with_debugger();
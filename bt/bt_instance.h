@@ -11,18 +11,53 @@
 #ifndef BT_INSTANCE_H
 #define BT_INSTANCE_H
 
+#include "bt_compiled_tree.h"
 #include "tasks/bt_task.h"
 
+#ifdef LIMBOAI_MODULE
+#include "core/variant/typed_array.h"
+#endif // LIMBOAI_MODULE
+
+#ifdef LIMBOAI_GDEXTENSION
+#include <godot_cpp/variant/typed_array.hpp>
+#endif // LIMBOAI_GDEXTENSION
+
 class BTInstance : public RefCounted {
 	GDCLASS(BTInstance, RefCounted);
+	friend class BehaviorTree;
+	friend class BTInstancePool;
+
+public:
+	enum UpdatedSignalMode : unsigned int {
+		SIGNAL_ALWAYS, // emit "updated" after every update
+		SIGNAL_ON_STATUS_CHANGE, // emit "updated" only if the status differs from the previous update
+	};
+
+	// Low-overhead alternative to the "updated" signal for C++ listeners. Called after every update.
+	typedef void (*UpdateCallback)(BTInstance *p_instance, BT::Status p_status, void *p_userdata);
 
 private:
 	Ref<BTTask> root_task;
+	BTCompiledTree compiled_tree;
 	uint64_t owner_node_id = 0;
 	String source_bt_path;
+	uint64_t source_bt_id = 0; // Instance ID of the BehaviorTree, if created from one.
+	uint64_t source_generation = 0; // BehaviorTree::prototype_generation at creation, see BTInstancePool::release().
 	BT::Status last_status = BT::FRESH;
+	BT::Status previous_status = BT::FRESH;
+	UpdatedSignalMode updated_signal_mode = SIGNAL_ALWAYS;
+	UpdateCallback update_callback = nullptr;
+	void *update_callback_userdata = nullptr;
+	bool resume_at_running_task = false;
+	bool thread_safe = false; // All tasks are thread-safe, see is_thread_safe().
+	LocalVector<Ref<Blackboard>> scopes; // Distinct blackboards of the tasks, the root task's first.
+	int resume_index = -1; // Index of the task to resume at in compiled_tree, or -1.
+	bool reusable = false; // All tasks are reset by abort(), and the hierarchy is unmodified, see BTInstancePool.
+	bool pooled = false; // Released to BTInstancePool, and not acquired since.
 
 #ifdef DEBUG_ENABLED
+	// Set by LimboDebugger while the instance is tracked. Called after every update, regardless of updated_signal_mode.
+	UpdateCallback debugger_callback = nullptr;
 	bool monitor_performance = false;
 	StringName monitor_id;
 	double update_time_acc = 0.0;
@@ -34,6 +69,20 @@ private:
 
 #endif // * DEBUG_ENABLED
 
+	BT::Status _resume(double p_delta);
+	bool _check_thread_safe() const;
+	bool _check_reusable() const;
+	void _disconnect_all(const StringName &p_signal);
+	void _update_scopes();
+	void _release_scopes();
+
+	// Used by BTInstancePool.
+	void _recycle();
+	void _rebind(Node *p_agent, const Ref<Blackboard> &p_blackboard, Node *p_owner_node, Node *p_scene_root);
+
+	static void _update_batch_task(void *p_userdata, uint32_t p_index);
+	static void _on_wake(void *p_userdata);
+
 protected:
 	static void _bind_methods();
 
@@ -45,6 +94,7 @@ public:
 	_FORCE_INLINE_ Ref<BTTask> get_root_task() const { return root_task; }
 	Node *get_owner_node() const;
 	_FORCE_INLINE_ BT::Status get_last_status() const { return last_status; }
+	_FORCE_INLINE_ bool is_status_changed() const { return last_status != previous_status; }
 	_FORCE_INLINE_ String get_source_bt_path() const { return source_bt_path; }
 	_FORCE_INLINE_ Node *get_agent() const { return root_task.is_valid() ? root_task->get_agent() : nullptr; }
 	_FORCE_INLINE_ Ref<Blackboard> get_blackboard() const { return root_task.is_valid() ? root_task->get_blackboard() : Ref<Blackboard>(); }
@@ -53,16 +103,48 @@ public:
 
 	BT::Status update(double p_delta);
 
+	// Same as update(), but doesn't emit the "updated" signal, so it can be called from a worker thread
+	// if the instance is thread-safe. Call emit_updated() on the main thread afterwards.
+	BT::Status update_threaded(double p_delta);
+	void emit_updated();
+
+	// Checked before each threaded update, as blackboard scopes may become shared at any time.
+	bool is_thread_safe() const;
+
+	// True if the last update ended with the running path suspended, see BTTask::suspend().
+	// Updates do nothing until a task is resumed, which emits the "resumed" signal.
+	_FORCE_INLINE_ bool is_suspended() const { return compiled_tree.is_asleep(); }
+	// Adds time that passed without updates to the running path, e.g. while the owner stopped
+	// updating a suspended instance. Updates of a suspended instance account for their delta already.
+	void add_sleep_time(double p_seconds);
+
+	void set_updated_signal_mode(UpdatedSignalMode p_mode) { updated_signal_mode = p_mode; }
+	UpdatedSignalMode get_updated_signal_mode() const { return updated_signal_mode; }
+
+	void set_update_callback(UpdateCallback p_callback, void *p_userdata = nullptr);
+#ifdef DEBUG_ENABLED
+	void set_debugger_callback(UpdateCallback p_callback) { debugger_callback = p_callback; }
+#endif
+
+	static void update_batch(const TypedArray<BTInstance> &p_instances, double p_delta);
+
+	void set_resume_at_running_task(bool p_enable);
+	bool get_resume_at_running_task() const { return resume_at_running_task; }
+
 	void set_monitor_performance(bool p_monitor);
 	bool get_monitor_performance() const;
 
 	void register_with_debugger();
 	void unregister_with_debugger();
 
-	static Ref<BTInstance> create(Ref<BTTask> p_root_task, String p_source_bt_path, Node *p_owner_node);
+	// If r_shared_layout is given, the compiled structure is shared with the other instances that use it.
+	// It's set to the new instance's structure if it isn't valid yet. See BehaviorTree::instantiate().
+	static Ref<BTInstance> create(Ref<BTTask> p_root_task, String p_source_bt_path, Node *p_owner_node, bool p_thread_safe = false, BTCompiledTree::Layout *r_shared_layout = nullptr);
 
 	BTInstance() = default;
 	~BTInstance();
 };
 
+VARIANT_ENUM_CAST(BTInstance::UpdatedSignalMode);
+
 #endif // BT_INSTANCE_H
@@ -0,0 +1,128 @@
+/**
+ * bt_instance_pool.cpp
+ * =============================================================================
+ * Copyright (c) 2023-present Serhii Snitsaruk and the LimboAI contributors.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#include "bt_instance_pool.h"
+
+#include "../util/limbo_string_names.h"
+
+void BTInstancePool::set_behavior_tree(const Ref<BehaviorTree> &p_tree) {
+	if (behavior_tree == p_tree) {
+		return;
+	}
+	clear();
+	if (behavior_tree.is_valid() && behavior_tree->is_connected(LW_NAME(changed), callable_mp(this, &BTInstancePool::clear))) {
+		behavior_tree->disconnect(LW_NAME(changed), callable_mp(this, &BTInstancePool::clear));
+	}
+	behavior_tree = p_tree;
+	if (behavior_tree.is_valid()) {
+		behavior_tree->connect(LW_NAME(changed), callable_mp(this, &BTInstancePool::clear));
+		prototype_generation = behavior_tree->prototype_generation;
+	}
+}
+
+void BTInstancePool::_discard_stale() {
+	// * Edits to the source tasks at runtime replace the prototype without emitting "changed" on the tree.
+	if (prototype_generation != behavior_tree->prototype_generation) {
+		clear();
+		prototype_generation = behavior_tree->prototype_generation;
+	}
+}
+
+void BTInstancePool::prewarm(int p_count) {
+	ERR_FAIL_COND_MSG(behavior_tree.is_null(), "BTInstancePool: Behavior tree is not set.");
+	ERR_FAIL_COND_MSG(behavior_tree->get_root_task().is_null(), "BTInstancePool: Behavior tree has no valid root task.");
+	Ref<BTTask> prototype = behavior_tree->get_runtime_prototype();
+	ERR_FAIL_COND_MSG(prototype.is_null(), "BTInstancePool: Prewarm failed - root task is disabled.");
+	_discard_stale();
+	for (int i = 0; i < p_count; i++) {
+		free_trees.push_back(prototype->clone());
+	}
+}
+
+Ref<BTInstance> BTInstancePool::acquire(Node *p_agent, const Ref<Blackboard> &p_blackboard, Node *p_instance_owner, Node *p_custom_scene_root) {
+	ERR_FAIL_COND_V_MSG(behavior_tree.is_null(), nullptr, "BTInstancePool: Behavior tree is not set.");
+	ERR_FAIL_NULL_V_MSG(p_agent, nullptr, "BTInstancePool: Acquire failed - agent can't be null.");
+	ERR_FAIL_NULL_V_MSG(p_instance_owner, nullptr, "BTInstancePool: Acquire failed - instance owner can't be null.");
+	ERR_FAIL_COND_V_MSG(p_blackboard.is_null(), nullptr, "BTInstancePool: Acquire failed - blackboard can't be null.");
+	Node *scene_root = p_custom_scene_root ? p_custom_scene_root : p_instance_owner->get_owner();
+	ERR_FAIL_NULL_V_MSG(scene_root, nullptr, "BTInstancePool: Acquire failed - unable to establish scene root. This is likely due to the instance owner not being owned by a scene node and custom_scene_root being null.");
+
+	_discard_stale();
+	if (!free_instances.is_empty()) {
+		hit_count += 1;
+		Ref<BTInstance> inst = free_instances[free_instances.size() - 1];
+		free_instances.resize(free_instances.size() - 1);
+		inst->_rebind(p_agent, p_blackboard, p_instance_owner, scene_root);
+		return inst;
+	}
+
+	Ref<BTTask> root;
+	if (!free_trees.is_empty()) {
+		hit_count += 1;
+		root = free_trees[free_trees.size() - 1];
+		free_trees.resize(free_trees.size() - 1);
+	} else {
+		miss_count += 1;
+		ERR_FAIL_COND_V_MSG(behavior_tree->get_root_task().is_null(), nullptr, "BTInstancePool: Behavior tree has no valid root task.");
+		Ref<BTTask> prototype = behavior_tree->get_runtime_prototype();
+		ERR_FAIL_COND_V_MSG(prototype.is_null(), nullptr, "BTInstancePool: Acquire failed - root task is disabled.");
+		root = prototype->clone();
+	}
+	root->initialize(p_agent, p_blackboard, scene_root);
+	return behavior_tree->_create_instance(root, p_instance_owner);
+}
+
+void BTInstancePool::release(const Ref<BTInstance> &p_instance) {
+	ERR_FAIL_COND(p_instance.is_null());
+	ERR_FAIL_COND_MSG(!p_instance->is_instance_valid(), "BTInstancePool: Can't release an invalid instance.");
+	ERR_FAIL_COND_MSG(p_instance->pooled, "BTInstancePool: Instance was already released.");
+	// * Built-in trees have no path, so compare the resource itself.
+	ERR_FAIL_COND_MSG(behavior_tree.is_null() || p_instance->source_bt_id != behavior_tree->get_instance_id(),
+			"BTInstancePool: Instance was not created from this pool's behavior tree.");
+	p_instance->_recycle();
+	_discard_stale();
+	if (p_instance->reusable && p_instance->source_generation == prototype_generation) {
+		free_instances.push_back(p_instance);
+	}
+	// * Otherwise, some task keeps state that abort() doesn't reset, the hierarchy was modified,
+	// or the tree changed since the instance was created, so the next acquire() starts from a fresh clone instead.
+}
+
+void BTInstancePool::clear() {
+	free_instances.clear();
+	free_trees.clear();
+}
+
+BTInstancePool::~BTInstancePool() {
+	if (behavior_tree.is_valid() && behavior_tree->is_connected(LW_NAME(changed), callable_mp(this, &BTInstancePool::clear))) {
+		behavior_tree->disconnect(LW_NAME(changed), callable_mp(this, &BTInstancePool::clear));
+	}
+}
+
+void BTInstancePool::reset_counters() {
+	hit_count = 0;
+	miss_count = 0;
+}
+
+void BTInstancePool::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("set_behavior_tree", "behavior_tree"), &BTInstancePool::set_behavior_tree);
+	ClassDB::bind_method(D_METHOD("get_behavior_tree"), &BTInstancePool::get_behavior_tree);
+	ClassDB::bind_method(D_METHOD("prewarm", "count"), &BTInstancePool::prewarm);
+	ClassDB::bind_method(D_METHOD("acquire", "agent", "blackboard", "instance_owner", "custom_scene_root"), &BTInstancePool::acquire, DEFVAL(Variant()));
+	ClassDB::bind_method(D_METHOD("release", "instance"), &BTInstancePool::release);
+	ClassDB::bind_method(D_METHOD("clear"), &BTInstancePool::clear);
+	ClassDB::bind_method(D_METHOD("get_available_count"), &BTInstancePool::get_available_count);
+	ClassDB::bind_method(D_METHOD("get_hit_count"), &BTInstancePool::get_hit_count);
+	ClassDB::bind_method(D_METHOD("get_miss_count"), &BTInstancePool::get_miss_count);
+	ClassDB::bind_method(D_METHOD("reset_counters"), &BTInstancePool::reset_counters);
+
+	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "behavior_tree", PROPERTY_HINT_RESOURCE_TYPE, "BehaviorTree"), "set_behavior_tree", "get_behavior_tree");
+}
@@ -0,0 +1,66 @@
+/**
+ * bt_instance_pool.h
+ * =============================================================================
+ * Copyright (c) 2023-present Serhii Snitsaruk and the LimboAI contributors.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#ifndef BT_INSTANCE_POOL_H
+#define BT_INSTANCE_POOL_H
+
+#include "behavior_tree.h"
+#include "bt_instance.h"
+
+#ifdef LIMBOAI_MODULE
+#include "core/templates/local_vector.h"
+#endif // LIMBOAI_MODULE
+
+#ifdef LIMBOAI_GDEXTENSION
+#include <godot_cpp/templates/local_vector.hpp>
+#endif // LIMBOAI_GDEXTENSION
+
+// Keeps instantiated task trees of a BehaviorTree for reuse, so that spawning agents
+// doesn't require cloning the whole tree each time.
+class BTInstancePool : public RefCounted {
+	GDCLASS(BTInstancePool, RefCounted);
+
+private:
+	Ref<BehaviorTree> behavior_tree;
+	LocalVector<Ref<BTInstance>> free_instances; // Released instances.
+	LocalVector<Ref<BTTask>> free_trees; // Pre-warmed clones, not initialized yet.
+	uint64_t prototype_generation = 0; // Of the tree's runtime prototype that the pooled trees were cloned from.
+	int hit_count = 0;
+	int miss_count = 0;
+
+	void _discard_stale();
+
+protected:
+	static void _bind_methods();
+
+#ifdef LIMBOAI_GDEXTENSION
+	String _to_string() const { return "<" + get_class() + "#" + itos(get_instance_id()) + ">"; }
+#endif
+
+public:
+	void set_behavior_tree(const Ref<BehaviorTree> &p_tree);
+	Ref<BehaviorTree> get_behavior_tree() const { return behavior_tree; }
+
+	void prewarm(int p_count);
+	Ref<BTInstance> acquire(Node *p_agent, const Ref<Blackboard> &p_blackboard, Node *p_instance_owner, Node *p_custom_scene_root = nullptr);
+	void release(const Ref<BTInstance> &p_instance);
+	void clear();
+
+	int get_available_count() const { return free_instances.size() + free_trees.size(); }
+	int get_hit_count() const { return hit_count; }
+	int get_miss_count() const { return miss_count; }
+	void reset_counters();
+
+	BTInstancePool() = default;
+	~BTInstancePool();
+};
+
+#endif // BT_INSTANCE_POOL_H
@@ -14,6 +14,7 @@
 #include "../compat/limbo_compat.h"
 #include "../compat/resource.h"
 #include "../util/limbo_string_names.h"
+#include "../util/limbo_tick_server.h"
 
 #ifdef LIMBOAI_MODULE
 #include "core/config/engine.h"
@@ -25,8 +26,15 @@
 
 VARIANT_ENUM_CAST(BTPlayer::UpdateMode);
 
+const LimboTickServer::ThreadedCallbacks BTPlayer::threaded_callbacks = {
+	&BTPlayer::_threaded_prepare,
+	&BTPlayer::_threaded_run,
+	&BTPlayer::_threaded_finish,
+};
+
 void BTPlayer::_instantiate_bt() {
 	bt_instance.unref();
+	paused_at = -1.0;
 	ERR_FAIL_COND_MSG(!behavior_tree.is_valid(), "BTPlayer: Initialization failed - needs a valid behavior tree.");
 	ERR_FAIL_COND_MSG(!behavior_tree->get_root_task().is_valid(), "BTPlayer: Initialization failed - behavior tree has no valid root task.");
 	Node *agent = get_node_or_null(agent_node);
@@ -36,6 +44,12 @@ void BTPlayer::_instantiate_bt() {
 			"BTPlayer: Initialization failed - unable to establish scene root. This is likely due to BTPlayer not being owned by a scene node. Check BTPlayer.set_scene_root_hint().");
 	bt_instance = behavior_tree->instantiate(agent, blackboard, this, scene_root);
 	ERR_FAIL_COND_MSG(bt_instance.is_null(), "BTPlayer: Failed to instantiate behavior tree.");
+	bt_instance->set_resume_at_running_task(resume_at_running_task);
+	bt_instance->set_updated_signal_mode(updated_signal_mode);
+	_connect_bt_instance();
+	if (tick_server_process) {
+		_update_tick_server_registration();
+	}
 #ifdef DEBUG_ENABLED
 	bt_instance->set_monitor_performance(monitor_performance);
 	bt_instance->register_with_debugger();
@@ -71,8 +85,15 @@ void BTPlayer::set_bt_instance(const Ref<BTInstance> &p_bt_instance) {
 	ERR_FAIL_COND_MSG(!p_bt_instance->is_instance_valid(), "BTPlayer: Failed to set behavior tree instance - instance is not valid.");
 
 	bt_instance = p_bt_instance;
+	paused_at = -1.0;
 	blackboard = p_bt_instance->get_blackboard();
 	agent_node = p_bt_instance->get_agent()->get_path();
+	resume_at_running_task = p_bt_instance->get_resume_at_running_task();
+	updated_signal_mode = p_bt_instance->get_updated_signal_mode();
+	_connect_bt_instance();
+	if (tick_server_process) {
+		_update_tick_server_registration();
+	}
 
 #ifdef DEBUG_ENABLED
 	bt_instance->set_monitor_performance(monitor_performance);
@@ -128,14 +149,119 @@ void BTPlayer::set_update_mode(UpdateMode p_mode) {
 	set_active(active);
 }
 
+void BTPlayer::set_priority(double p_priority) {
+	priority = p_priority;
+	if (LimboTickServer::get_singleton() && LimboTickServer::get_singleton()->is_node_registered(this)) {
+		LimboTickServer::get_singleton()->set_node_priority(this, priority);
+	}
+}
+
 void BTPlayer::set_active(bool p_active) {
 	active = p_active;
 	bool is_not_editor = !Engine::get_singleton()->is_editor_hint();
-	set_process(update_mode == UpdateMode::IDLE && active && is_not_editor);
-	set_physics_process(update_mode == UpdateMode::PHYSICS && active && is_not_editor);
+	if (update_mode == UpdateMode::BUDGETED || LimboTickServer::is_enabled()) {
+		set_process(false);
+		set_physics_process(false);
+		_set_tick_server_process(update_mode != UpdateMode::MANUAL && active && is_not_editor);
+	} else {
+		if (tick_server_process) {
+			_set_tick_server_process(false);
+		}
+		set_process(update_mode == UpdateMode::IDLE && active && is_not_editor);
+		set_physics_process(update_mode == UpdateMode::PHYSICS && active && is_not_editor);
+	}
 	set_process_input(active && is_not_editor);
 }
 
+void BTPlayer::_set_tick_server_process(bool p_enable) {
+	tick_server_process = p_enable;
+	_update_tick_server_registration();
+}
+
+LimboTickServer::TickGroup BTPlayer::_get_tick_group() const {
+	if (update_mode == UpdateMode::PHYSICS) {
+		return LimboTickServer::TICK_PHYSICS;
+	} else if (update_mode == UpdateMode::BUDGETED) {
+		return LimboTickServer::TICK_BUDGETED;
+	}
+	return LimboTickServer::TICK_IDLE;
+}
+
+void BTPlayer::_update_tick_server_registration() {
+	LimboTickServer *server = LimboTickServer::get_singleton();
+	ERR_FAIL_NULL(server);
+	// * Like regular processing, ticks are only received while inside the scene tree.
+	if (tick_server_process && is_inside_tree()) {
+		const LimboTickServer::TickGroup group = _get_tick_group();
+		const bool threaded = bt_instance.is_valid() && bt_instance->is_thread_safe();
+		server->register_node(this, group, &BTPlayer::_tick_server_callback, threaded ? &threaded_callbacks : nullptr);
+		server->set_node_priority(this, priority);
+	} else {
+		server->unregister_node(this);
+	}
+}
+
+void BTPlayer::_tick_server_callback(Node *p_node, double p_delta) {
+	static_cast<BTPlayer *>(p_node)->_auto_update(p_delta);
+}
+
+bool BTPlayer::_advance_lod(double &r_delta) {
+	// * The budget scheduler already spaces out updates in BUDGETED mode, so LOD is not applied there.
+	// * Both the main-thread and the threaded path go through here to follow the same rule.
+	if (update_mode == UpdateMode::BUDGETED || !lod.is_enabled()) {
+		return true;
+	}
+	Node *agent = bt_instance.is_valid() ? bt_instance->get_agent() : nullptr;
+	return lod.advance(r_delta, this, agent, r_delta);
+}
+
+void BTPlayer::_auto_update(double p_delta) {
+	if (!_advance_lod(p_delta)) {
+		return;
+	}
+	if (fixed_tick_rate <= 0.0) {
+		update(p_delta);
+	} else if (bt_instance.is_valid() && active) {
+		// * Fixed steps only apply to automatic updates: update() always executes the tree once.
+		const int num_steps = _advance_fixed_step(p_delta);
+		_update_steps(p_delta, num_steps);
+	}
+}
+
+bool BTPlayer::_threaded_prepare(Node *p_node, double p_delta) {
+	BTPlayer *player = static_cast<BTPlayer *>(p_node);
+	if (!player->active || player->bt_instance.is_null()) {
+		return false;
+	}
+	if (!player->bt_instance->is_thread_safe()) {
+		// * Blackboard became shared since registration: update on the main thread instead.
+		_tick_server_callback(p_node, p_delta);
+		return false;
+	}
+	if (!player->_advance_lod(p_delta)) {
+		return false;
+	}
+	player->threaded_steps = player->_advance_fixed_step(p_delta);
+	player->threaded_delta = p_delta;
+	return player->threaded_steps > 0;
+}
+
+void BTPlayer::_threaded_run(Node *p_node) {
+	BTPlayer *player = static_cast<BTPlayer *>(p_node);
+	for (int i = 0; i < player->threaded_steps; i++) {
+		player->bt_instance->update_threaded(player->threaded_delta);
+	}
+}
+
+void BTPlayer::_threaded_finish(Node *p_node) {
+	BTPlayer *player = static_cast<BTPlayer *>(p_node);
+	if (player->bt_instance.is_valid()) {
+		player->bt_instance->emit_updated();
+		player->_emit_update_signals(player->bt_instance->get_last_status());
+		player->_pause_while_suspended();
+	}
+}
+
 void BTPlayer::update(double p_delta) {
 	if (!bt_instance.is_valid()) {
 		ERR_PRINT_ONCE(vformat("BTPlayer doesn't have a behavior tree with a valid root task to execute (owner: %s)", get_owner()));
@@ -143,22 +269,118 @@ void BTPlayer::update(double p_delta) {
 	}
 
 	if (active) {
+		_update_steps(p_delta, 1);
+	}
+}
+
+void BTPlayer::_update_steps(double p_delta, int p_num_steps) {
+	for (int i = 0; i < p_num_steps; i++) {
 		BT::Status status = bt_instance->update(p_delta);
-		emit_signal(LW_NAME(updated), status);
-#ifndef DISABLE_DEPRECATED
-		if (status == BTTask::SUCCESS || status == BTTask::FAILURE) {
-			emit_signal(LW_NAME(behavior_tree_finished), status);
+		_emit_update_signals(status);
+	}
+	_pause_while_suspended();
+}
+
+void BTPlayer::_connect_bt_instance() {
+	if (!bt_instance->is_connected(LW_NAME(resumed), callable_mp(this, &BTPlayer::_on_bt_resumed))) {
+		bt_instance->connect(LW_NAME(resumed), callable_mp(this, &BTPlayer::_on_bt_resumed));
+	}
+}
+
+void BTPlayer::_pause_while_suspended() {
+	if (!bt_instance->is_suspended() || update_mode == UpdateMode::MANUAL) {
+		return;
+	}
+	// * Stop processing until the tree is resumed, see BTTask::suspend().
+	paused_at = LimboTickServer::get_singleton()->get_group_time(_get_tick_group());
+	set_process(false);
+	set_physics_process(false);
+	if (tick_server_process) {
+		_set_tick_server_process(false);
+	}
+}
+
+void BTPlayer::_on_bt_resumed() {
+	if (bt_instance.is_valid() && !bt_instance->is_suspended()) {
+		if (paused_usec != 0) {
+			// * Time passed while not processing still counts towards the elapsed time of the running tasks.
+			const double slept = (Time::get_singleton()->get_ticks_usec() - paused_usec) / 1000000.0;
+			bt_instance->add_sleep_time(slept * Engine::get_singleton()->get_time_scale());
+			paused_at = -1.0;
 		}
-#endif // DISABLE_DEPRECATED
+		set_active(active);
+	}
+}
+
+int BTPlayer::_advance_fixed_step(double &r_delta) {
+	if (fixed_tick_rate <= 0.0) {
+		return 1;
+	}
+	const double step = 1.0 / fixed_tick_rate;
+	fixed_accumulator += r_delta;
+	int num_steps = 0;
+	while (fixed_accumulator >= step && num_steps < fixed_max_steps) {
+		fixed_accumulator -= step;
+		num_steps += 1;
+	}
+	if (fixed_accumulator >= step) {
+		// * Too far behind: drop the excess time rather than trying to catch up later.
+		fixed_accumulator = Math::fmod(fixed_accumulator, step);
 	}
+	r_delta = step;
+	return num_steps;
+}
+
+void BTPlayer::set_fixed_tick_rate(double p_rate) {
+	fixed_tick_rate = MAX(0.0, p_rate);
+	fixed_accumulator = 0.0;
+}
+
+void BTPlayer::set_fixed_max_steps(int p_max_steps) {
+	fixed_max_steps = MAX(1, p_max_steps);
+}
+
+double BTPlayer::get_interpolation_alpha() const {
+	if (fixed_tick_rate <= 0.0) {
+		return 1.0;
+	}
+	return CLAMP(fixed_accumulator * fixed_tick_rate, 0.0, 1.0);
+}
+
+void BTPlayer::_emit_update_signals(BT::Status p_status) {
+	const bool gated = updated_signal_mode == BTInstance::SIGNAL_ON_STATUS_CHANGE && !bt_instance->is_status_changed();
+	// * Skip packing the arguments if nobody is listening.
+	if (!gated && has_connections(LW_NAME(updated))) {
+		emit_signal(LW_NAME(updated), p_status);
+	}
+#ifndef DISABLE_DEPRECATED
+	if ((p_status == BTTask::SUCCESS || p_status == BTTask::FAILURE) && has_connections(LW_NAME(behavior_tree_finished))) {
+		emit_signal(LW_NAME(behavior_tree_finished), p_status);
+	}
+#endif // DISABLE_DEPRECATED
 }
 
 void BTPlayer::restart() {
 	ERR_FAIL_COND_MSG(bt_instance.is_null(), "BTPlayer: Restart failed - no valid tree instance. Make sure the BTPlayer has a valid behavior tree with a valid root task.");
 	bt_instance->get_root_task()->abort();
+	fixed_accumulator = 0.0;
 	set_active(true);
 }
 
+void BTPlayer::set_resume_at_running_task(bool p_enable) {
+	resume_at_running_task = p_enable;
+	if (bt_instance.is_valid()) {
+		bt_instance->set_resume_at_running_task(resume_at_running_task);
+	}
+}
+
+void BTPlayer::set_updated_signal_mode(BTInstance::UpdatedSignalMode p_mode) {
+	updated_signal_mode = p_mode;
+	if (bt_instance.is_valid()) {
+		bt_instance->set_updated_signal_mode(updated_signal_mode);
+	}
+}
+
 void BTPlayer::set_monitor_performance(bool p_monitor_performance) {
 	monitor_performance = p_monitor_performance;
 
@@ -172,12 +394,10 @@ void BTPlayer::set_monitor_performance(bool p_monitor_performance) {
 void BTPlayer::_notification(int p_notification) {
 	switch (p_notification) {
 		case NOTIFICATION_PROCESS: {
-			Variant time = get_process_delta_time();
-			update(time);
+			_auto_update(get_process_delta_time());
 		} break;
 		case NOTIFICATION_PHYSICS_PROCESS: {
-			Variant time = get_physics_process_delta_time();
-			update(time);
+			_auto_update(get_physics_process_delta_time());
 		} break;
 		case NOTIFICATION_READY: {
 			if (!Engine::get_singleton()->is_editor_hint()) {
@@ -188,6 +408,9 @@ void BTPlayer::_notification(int p_notification) {
 			set_active(active);
 		} break;
 		case NOTIFICATION_ENTER_TREE: {
+			if (tick_server_process) {
+				_update_tick_server_registration();
+			}
 #ifdef DEBUG_ENABLED
 			if (bt_instance.is_valid()) {
 				bt_instance->set_monitor_performance(monitor_performance);
@@ -196,6 +419,9 @@ void BTPlayer::_notification(int p_notification) {
 #endif // DEBUG_ENABLED
 		} break;
 		case NOTIFICATION_EXIT_TREE: {
+			if (tick_server_process) {
+				LimboTickServer::get_singleton()->unregister_node(this);
+			}
 #ifdef DEBUG_ENABLED
 			if (bt_instance.is_valid()) {
 				bt_instance->set_monitor_performance(false);
@@ -219,17 +445,39 @@ void BTPlayer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_agent_node"), &BTPlayer::get_agent_node);
 	ClassDB::bind_method(D_METHOD("set_update_mode", "update_mode"), &BTPlayer::set_update_mode);
 	ClassDB::bind_method(D_METHOD("get_update_mode"), &BTPlayer::get_update_mode);
+	ClassDB::bind_method(D_METHOD("set_priority", "priority"), &BTPlayer::set_priority);
+	ClassDB::bind_method(D_METHOD("get_priority"), &BTPlayer::get_priority);
 	ClassDB::bind_method(D_METHOD("set_active", "active"), &BTPlayer::set_active);
 	ClassDB::bind_method(D_METHOD("get_active"), &BTPlayer::get_active);
+	ClassDB::bind_method(D_METHOD("set_lod_level", "level"), &BTPlayer::set_lod_level);
+	ClassDB::bind_method(D_METHOD("get_lod_level"), &BTPlayer::get_lod_level);
+	ClassDB::bind_method(D_METHOD("set_lod_level_callback", "callback"), &BTPlayer::set_lod_level_callback);
+	ClassDB::bind_method(D_METHOD("get_lod_level_callback"), &BTPlayer::get_lod_level_callback);
+	ClassDB::bind_method(D_METHOD("set_lod_distances", "distances"), &BTPlayer::set_lod_distances);
+	ClassDB::bind_method(D_METHOD("get_lod_distances"), &BTPlayer::get_lod_distances);
+	ClassDB::bind_method(D_METHOD("set_lod_reference_node", "path"), &BTPlayer::set_lod_reference_node);
+	ClassDB::bind_method(D_METHOD("get_lod_reference_node"), &BTPlayer::get_lod_reference_node);
 	ClassDB::bind_method(D_METHOD("set_blackboard", "blackboard"), &BTPlayer::set_blackboard);
 	ClassDB::bind_method(D_METHOD("get_blackboard"), &BTPlayer::get_blackboard);
 
 	ClassDB::bind_method(D_METHOD("set_blackboard_plan", "plan"), &BTPlayer::set_blackboard_plan);
 	ClassDB::bind_method(D_METHOD("get_blackboard_plan"), &BTPlayer::get_blackboard_plan);
 
+	ClassDB::bind_method(D_METHOD("set_resume_at_running_task", "enable"), &BTPlayer::set_resume_at_running_task);
+	ClassDB::bind_method(D_METHOD("get_resume_at_running_task"), &BTPlayer::get_resume_at_running_task);
+
+	ClassDB::bind_method(D_METHOD("set_updated_signal_mode", "mode"), &BTPlayer::set_updated_signal_mode);
+	ClassDB::bind_method(D_METHOD("get_updated_signal_mode"), &BTPlayer::get_updated_signal_mode);
+
 	ClassDB::bind_method(D_METHOD("set_monitor_performance", "enable"), &BTPlayer::set_monitor_performance);
 	ClassDB::bind_method(D_METHOD("get_monitor_performance"), &BTPlayer::get_monitor_performance);
 
+	ClassDB::bind_method(D_METHOD("set_fixed_tick_rate", "rate"), &BTPlayer::set_fixed_tick_rate);
+	ClassDB::bind_method(D_METHOD("get_fixed_tick_rate"), &BTPlayer::get_fixed_tick_rate);
+	ClassDB::bind_method(D_METHOD("set_fixed_max_steps", "max_steps"), &BTPlayer::set_fixed_max_steps);
+	ClassDB::bind_method(D_METHOD("get_fixed_max_steps"), &BTPlayer::get_fixed_max_steps);
+	ClassDB::bind_method(D_METHOD("get_interpolation_alpha"), &BTPlayer::get_interpolation_alpha);
+
 	ClassDB::bind_method(D_METHOD("update", "delta"), &BTPlayer::update);
 	ClassDB::bind_method(D_METHOD("restart"), &BTPlayer::restart);
 
@@ -240,15 +488,26 @@ void BTPlayer::_bind_methods() {
 
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "behavior_tree", PROPERTY_HINT_RESOURCE_TYPE, "BehaviorTree"), "set_behavior_tree", "get_behavior_tree");
 	ADD_PROPERTY(PropertyInfo(Variant::NODE_PATH, "agent_node"), "set_agent_node", "get_agent_node");
-	ADD_PROPERTY(PropertyInfo(Variant::INT, "update_mode", PROPERTY_HINT_ENUM, "Idle,Physics,Manual"), "set_update_mode", "get_update_mode");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "update_mode", PROPERTY_HINT_ENUM, "Idle,Physics,Manual,Budgeted"), "set_update_mode", "get_update_mode");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "priority", PROPERTY_HINT_RANGE, "0,10,0.01,or_greater"), "set_priority", "get_priority");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "active"), "set_active", "get_active");
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "blackboard", PROPERTY_HINT_NONE, "Blackboard", 0), "set_blackboard", "get_blackboard");
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "blackboard_plan", PROPERTY_HINT_RESOURCE_TYPE, "BlackboardPlan", PROPERTY_USAGE_DEFAULT | PROPERTY_USAGE_EDITOR_INSTANTIATE_OBJECT | PROPERTY_USAGE_ALWAYS_DUPLICATE), "set_blackboard_plan", "get_blackboard_plan");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "resume_at_running_task"), "set_resume_at_running_task", "get_resume_at_running_task");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "updated_signal_mode", PROPERTY_HINT_ENUM, "Always,On Status Change"), "set_updated_signal_mode", "get_updated_signal_mode");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "monitor_performance"), "set_monitor_performance", "get_monitor_performance");
+	ADD_GROUP("LOD", "lod_");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "lod_level", PROPERTY_HINT_RANGE, "0,8,1,or_greater"), "set_lod_level", "get_lod_level");
+	ADD_PROPERTY(PropertyInfo(Variant::PACKED_FLOAT32_ARRAY, "lod_distances"), "set_lod_distances", "get_lod_distances");
+	ADD_PROPERTY(PropertyInfo(Variant::NODE_PATH, "lod_reference_node"), "set_lod_reference_node", "get_lod_reference_node");
+	ADD_GROUP("Fixed Step", "fixed_");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "fixed_tick_rate", PROPERTY_HINT_RANGE, "0,120,0.1,or_greater,suffix:Hz"), "set_fixed_tick_rate", "get_fixed_tick_rate");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "fixed_max_steps", PROPERTY_HINT_RANGE, "1,16,1,or_greater"), "set_fixed_max_steps", "get_fixed_max_steps");
 
 	BIND_ENUM_CONSTANT(IDLE);
 	BIND_ENUM_CONSTANT(PHYSICS);
 	BIND_ENUM_CONSTANT(MANUAL);
+	BIND_ENUM_CONSTANT(BUDGETED);
 
 	ADD_SIGNAL(MethodInfo("updated", PropertyInfo(Variant::INT, "status")));
 
@@ -14,6 +14,8 @@
 
 #include "../blackboard/blackboard.h"
 #include "../blackboard/blackboard_plan.h"
+#include "../util/limbo_tick_lod.h"
+#include "../util/limbo_tick_server.h"
 #include "behavior_tree.h"
 #include "bt_instance.h"
 #include "tasks/bt_task.h"
@@ -34,6 +36,7 @@ public:
 		IDLE, // automatically call update() during NOTIFICATION_PROCESS
 		PHYSICS, // automatically call update() during NOTIFICATION_PHYSICS
 		MANUAL, // manually update state machine, user must call update(delta)
+		BUDGETED, // update() is scheduled by LimboTickServer within a per-frame time budget
 	};
 
 private:
@@ -41,18 +44,48 @@ private:
 	NodePath agent_node;
 	Ref<BlackboardPlan> blackboard_plan;
 	UpdateMode update_mode = UpdateMode::PHYSICS;
+	double priority = 1.0;
 	bool active = true;
 	Ref<Blackboard> blackboard;
 	Node *scene_root_hint = nullptr;
+	bool resume_at_running_task = false;
+	BTInstance::UpdatedSignalMode updated_signal_mode = BTInstance::SIGNAL_ALWAYS;
 	bool monitor_performance = false;
+	double fixed_tick_rate = 0.0;
+	int fixed_max_steps = 4;
 
 	Ref<BTInstance> bt_instance;
+	bool tick_server_process = false;
+	LimboTickLOD lod;
+	double fixed_accumulator = 0.0;
+	double threaded_delta = 0.0;
+	int threaded_steps = 0;
+	double paused_at = -1.0; // Tick group time when processing stopped for a suspended tree, see _pause_while_suspended().
+
+	static const LimboTickServer::ThreadedCallbacks threaded_callbacks;
 
 	void _instantiate_bt();
 	void _update_blackboard_plan();
 	void _initialize();
 	_FORCE_INLINE_ Node *_get_scene_root() const { return scene_root_hint ? scene_root_hint : get_owner(); }
 
+	void _set_tick_server_process(bool p_enable);
+	LimboTickServer::TickGroup _get_tick_group() const;
+	void _update_tick_server_registration();
+	static void _tick_server_callback(Node *p_node, double p_delta);
+	void _auto_update(double p_delta);
+	bool _advance_lod(double &r_delta);
+	int _advance_fixed_step(double &r_delta);
+	void _update_steps(double p_delta, int p_num_steps);
+	void _emit_update_signals(BT::Status p_status);
+	void _pause_while_suspended();
+	void _on_bt_resumed();
+	void _connect_bt_instance();
+
+	static bool _threaded_prepare(Node *p_node, double p_delta);
+	static void _threaded_run(Node *p_node);
+	static void _threaded_finish(Node *p_node);
+
 protected:
 	static void _bind_methods();
 
@@ -75,15 +108,44 @@ public:
 	void set_update_mode(UpdateMode p_mode);
 	UpdateMode get_update_mode() const { return update_mode; }
 
+	void set_priority(double p_priority);
+	double get_priority() const { return priority; }
+
 	void set_active(bool p_active);
 	bool get_active() const { return active; }
 
+	void set_lod_level(int p_level) { lod.set_level(p_level); }
+	int get_lod_level() const { return lod.get_level(); }
+
+	void set_lod_level_callback(const Callable &p_callback) { lod.set_level_callback(p_callback); }
+	Callable get_lod_level_callback() const { return lod.get_level_callback(); }
+
+	void set_lod_distances(const PackedFloat32Array &p_distances) { lod.set_distances(p_distances); }
+	PackedFloat32Array get_lod_distances() const { return lod.get_distances(); }
+
+	void set_lod_reference_node(const NodePath &p_path) { lod.set_reference_node(p_path); }
+	NodePath get_lod_reference_node() const { return lod.get_reference_node(); }
+
 	Ref<Blackboard> get_blackboard() const { return blackboard; }
 	void set_blackboard(const Ref<Blackboard> &p_blackboard) { blackboard = p_blackboard; }
 
+	void set_resume_at_running_task(bool p_enable);
+	bool get_resume_at_running_task() const { return resume_at_running_task; }
+
+	void set_updated_signal_mode(BTInstance::UpdatedSignalMode p_mode);
+	BTInstance::UpdatedSignalMode get_updated_signal_mode() const { return updated_signal_mode; }
+
 	void set_monitor_performance(bool p_monitor_performance);
 	bool get_monitor_performance() const { return monitor_performance; }
 
+	void set_fixed_tick_rate(double p_rate);
+	double get_fixed_tick_rate() const { return fixed_tick_rate; }
+
+	void set_fixed_max_steps(int p_max_steps);
+	int get_fixed_max_steps() const { return fixed_max_steps; }
+
+	double get_interpolation_alpha() const;
+
 	void update(double p_delta);
 	void restart();
 
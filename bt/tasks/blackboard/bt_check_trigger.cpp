@@ -15,6 +15,9 @@
 
 void BTCheckTrigger::set_variable(const StringName &p_variable) {
 	variable = p_variable;
+	if (get_blackboard().is_valid()) {
+		variable_handle = get_blackboard()->get_var_handle(variable);
+	}
 	emit_changed();
 }
 
@@ -33,11 +36,15 @@ String BTCheckTrigger::_generate_name() {
 	return "CheckTrigger " + LimboUtility::get_singleton()->decorate_var(variable);
 }
 
+void BTCheckTrigger::_setup() {
+	variable_handle = get_blackboard()->get_var_handle(variable);
+}
+
 BT::Status BTCheckTrigger::_tick(double p_delta) {
 	ERR_FAIL_COND_V_MSG(variable == StringName(), FAILURE, "BBCheckVar: `variable` is not set.");
-	Variant trigger_value = get_blackboard()->get_var(variable, false);
+	Variant trigger_value = get_blackboard()->get_var_by_handle(variable_handle, false);
 	if (trigger_value == Variant(true)) {
-		get_blackboard()->set_var(variable, false);
+		get_blackboard()->set_var_by_handle(variable_handle, false);
 		return SUCCESS;
 	}
 	return FAILURE;
@@ -21,11 +21,16 @@ class BTCheckTrigger : public BTCondition {
 private:
 	StringName variable;
 
+	int variable_handle = -1;
+
 protected:
 	static void _bind_methods();
 
 	virtual String _generate_name() override;
+	virtual void _setup() override;
 	virtual Status _tick(double p_delta) override;
+	virtual bool _is_thread_safe() const override { return true; }
+	virtual bool _is_reusable() const override { return true; }
 
 public:
 	void set_variable(const StringName &p_variable);
@@ -23,6 +23,9 @@
 
 void BTCheckVar::set_variable(const StringName &p_variable) {
 	variable = p_variable;
+	if (get_blackboard().is_valid()) {
+		variable_handle = get_blackboard()->get_var_handle(variable);
+	}
 	emit_changed();
 }
 
@@ -61,15 +64,34 @@ String BTCheckVar::_generate_name() {
 			value.is_valid() ? Variant(value) : Variant("???"));
 }
 
+void BTCheckVar::_setup() {
+	variable_handle = get_blackboard()->get_var_handle(variable);
+}
+
 BT::Status BTCheckVar::_tick(double p_delta) {
 	ERR_FAIL_COND_V_MSG(variable == StringName(), FAILURE, "BTCheckVar: `variable` is not set.");
 	ERR_FAIL_COND_V_MSG(!value.is_valid(), FAILURE, "BTCheckVar: `value` is not set.");
 
-	ERR_FAIL_COND_V_MSG(!get_blackboard()->has_var(variable), FAILURE, vformat("BTCheckVar: Blackboard variable doesn't exist: \"%s\". Returning FAILURE.", variable));
+	const Ref<Blackboard> bb = get_blackboard();
+	ERR_FAIL_COND_V_MSG(!bb->has_var_by_handle(variable_handle), FAILURE, vformat("BTCheckVar: Blackboard variable doesn't exist: \"%s\". Returning FAILURE.", variable));
+
+	Variant right_value = value->get_value(get_scene_root(), bb);
 
-	Variant left_value = get_blackboard()->get_var(variable, Variant());
-	Variant right_value = value->get_value(get_scene_root(), get_blackboard());
+	// * Numbers and booleans are read through the typed accessors, following perform_check() semantics:
+	// * ints compare exactly, mixed int/float compare as floats.
+	const Variant::Type left_type = bb->get_var_type_by_handle(variable_handle);
+	const Variant::Type right_type = right_value.get_type();
+	if (left_type == Variant::INT && right_type == Variant::INT) {
+		return LimboUtility::compare<int64_t>(check_type, bb->get_int_by_handle(variable_handle), right_value) ? SUCCESS : FAILURE;
+	}
+	if ((left_type == Variant::FLOAT || left_type == Variant::INT) && (right_type == Variant::FLOAT || right_type == Variant::INT)) {
+		return LimboUtility::compare<double>(check_type, bb->get_float_by_handle(variable_handle), right_value) ? SUCCESS : FAILURE;
+	}
+	if (left_type == Variant::BOOL && right_type == Variant::BOOL) {
+		return LimboUtility::compare<bool>(check_type, bb->get_bool_by_handle(variable_handle), right_value) ? SUCCESS : FAILURE;
+	}
 
+	Variant left_value = bb->get_var_by_handle(variable_handle, Variant());
 	return LimboUtility::get_singleton()->perform_check(check_type, left_value, right_value) ? SUCCESS : FAILURE;
 }
 
@@ -31,6 +31,10 @@ String BTSetVar::_generate_name() {
 			value.is_valid() ? Variant(value) : Variant("???"));
 }
 
+void BTSetVar::_setup() {
+	variable_handle = get_blackboard()->get_var_handle(variable);
+}
+
 BT::Status BTSetVar::_tick(double p_delta) {
 	ERR_FAIL_COND_V_MSG(variable == StringName(), FAILURE, "BTSetVar: `variable` is not set.");
 	ERR_FAIL_COND_V_MSG(!value.is_valid(), FAILURE, "BTSetVar: `value` is not set.");
@@ -40,18 +44,65 @@ BT::Status BTSetVar::_tick(double p_delta) {
 	ERR_FAIL_COND_V_MSG(right_value == error_result, FAILURE, "BTSetVar: Failed to get parameter value. Returning FAILURE.");
 	if (operation == LimboUtility::OPERATION_NONE) {
 		result = right_value;
-	} else if (operation != LimboUtility::OPERATION_NONE) {
-		Variant left_value = get_blackboard()->get_var(variable, error_result);
+	} else if (_perform_typed_operation(right_value)) {
+		return SUCCESS;
+	} else {
+		Variant left_value = get_blackboard()->get_var_by_handle(variable_handle, error_result);
 		ERR_FAIL_COND_V_MSG(left_value == error_result, FAILURE, vformat("BTSetVar: Failed to get \"%s\" blackboard variable. Returning FAILURE.", variable));
 		result = LimboUtility::get_singleton()->perform_operation(operation, left_value, right_value);
 		ERR_FAIL_COND_V_MSG(result == Variant(), FAILURE, "BTSetVar: Operation not valid. Returning FAILURE.");
 	}
-	get_blackboard()->set_var(variable, result);
+	get_blackboard()->set_var_by_handle(variable_handle, result);
 	return SUCCESS;
 };
 
+bool BTSetVar::_perform_typed_operation(const Variant &p_right_value) {
+	// * Numbers and vectors of the same type are combined through the typed accessors.
+	const Ref<Blackboard> bb = get_blackboard();
+	const Variant::Type type = p_right_value.get_type();
+	if (bb->get_var_type_by_handle(variable_handle) != type) {
+		return false;
+	}
+	switch (type) {
+		case Variant::INT: {
+			int64_t result;
+			if (LimboUtility::operate<int64_t>(operation, bb->get_int_by_handle(variable_handle), p_right_value, result)) {
+				bb->set_int_by_handle(variable_handle, result);
+				return true;
+			}
+		} break;
+		case Variant::FLOAT: {
+			double result;
+			if (LimboUtility::operate<double>(operation, bb->get_float_by_handle(variable_handle), p_right_value, result)) {
+				bb->set_float_by_handle(variable_handle, result);
+				return true;
+			}
+		} break;
+		case Variant::VECTOR2: {
+			Vector2 result;
+			if (LimboUtility::operate<Vector2>(operation, bb->get_vector2_by_handle(variable_handle), p_right_value, result)) {
+				bb->set_vector2_by_handle(variable_handle, result);
+				return true;
+			}
+		} break;
+		case Variant::VECTOR3: {
+			Vector3 result;
+			if (LimboUtility::operate<Vector3>(operation, bb->get_vector3_by_handle(variable_handle), p_right_value, result)) {
+				bb->set_vector3_by_handle(variable_handle, result);
+				return true;
+			}
+		} break;
+		default: {
+		} break;
+	}
+	return false;
+}
+
 void BTSetVar::set_variable(const StringName &p_variable) {
 	variable = p_variable;
+	if (get_blackboard().is_valid()) {
+		variable_handle = get_blackboard()->get_var_handle(variable);
+	}
 	emit_changed();
 }
 
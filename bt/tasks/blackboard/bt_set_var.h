@@ -26,11 +26,18 @@ private:
 	Ref<BBVariant> value;
 	LimboUtility::Operation operation = LimboUtility::OPERATION_NONE;
 
+	int variable_handle = -1;
+
+	bool _perform_typed_operation(const Variant &p_right_value);
+
 protected:
 	static void _bind_methods();
 
 	virtual String _generate_name() override;
+	virtual void _setup() override;
 	virtual Status _tick(double p_delta) override;
+	virtual bool _is_thread_safe() const override { return value.is_null() || value->is_thread_safe(); }
+	virtual bool _is_reusable() const override { return true; }
 
 public:
 	virtual PackedStringArray get_configuration_warnings() override;
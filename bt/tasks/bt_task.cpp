@@ -11,20 +11,28 @@
 
 #include "bt_task.h"
 
+#include "../../blackboard/bb_param/bb_param.h"
 #include "../../compat/object.h"
 #include "../../compat/print.h"
 #include "../../util/limbo_string_names.h"
 #include "../behavior_tree.h"
+#include "../bt_compiled_tree.h"
 
 #ifdef LIMBOAI_MODULE
 #include "core/config/engine.h"
 #include "core/object/script_language.h"
+#include "core/os/mutex.h"
 #include "core/templates/hash_map.h"
+#include "scene/main/scene_tree.h"
 #endif // LIMBOAI_MODULE
 
 #ifdef LIMBOAI_GDEXTENSION
 #include <godot_cpp/classes/engine.hpp>
+#include <godot_cpp/classes/mutex.hpp>
+#include <godot_cpp/classes/scene_tree.hpp>
+#include <godot_cpp/classes/scene_tree_timer.hpp>
 #include <godot_cpp/classes/script.hpp>
+#include <godot_cpp/core/mutex_lock.hpp>
 #include <godot_cpp/templates/hash_map.hpp>
 #endif // LIMBOAI_GDEXTENSION
 
@@ -73,6 +81,8 @@ Array BTTask::_get_children() const {
 }
 
 void BTTask::_set_children(Array p_children) {
+	_invalidate_compiled();
+
 	const int num_children = p_children.size();
 	int num_null = 0;
 
@@ -121,17 +131,26 @@ bool BTTask::is_enabled_in_tree() const {
 	return true;
 }
 
+BTTask::ColdData *BTTask::_get_cold() {
+	if (data.cold == nullptr) {
+		data.cold = memnew(ColdData);
+	}
+	return data.cold;
+}
+
 void BTTask::set_display_collapsed(bool p_display_collapsed) {
-	data.display_collapsed = p_display_collapsed;
+	if (data.cold || p_display_collapsed) {
+		_get_cold()->display_collapsed = p_display_collapsed;
+	}
 }
 
 bool BTTask::is_displayed_collapsed() const {
-	return data.display_collapsed;
+	return data.cold && data.cold->display_collapsed;
 }
 
 String BTTask::get_task_name() {
-	if (!data.custom_name.is_empty()) {
-		return data.custom_name;
+	if (data.cold && !data.cold->custom_name.is_empty()) {
+		return data.cold->custom_name;
 	}
 
 	Ref<Script> task_script = get_script();
@@ -167,8 +186,8 @@ Ref<BTTask> BTTask::get_root() const {
 }
 
 void BTTask::set_custom_name(const String &p_name) {
-	if (data.custom_name != p_name) {
-		data.custom_name = p_name;
+	if (get_custom_name() != p_name) {
+		_get_cold()->custom_name = p_name;
 		emit_changed();
 	}
 };
@@ -184,44 +203,221 @@ void BTTask::initialize(Node *p_agent, const Ref<Blackboard> &p_blackboard, Node
 		get_child(i)->initialize(p_agent, p_blackboard, p_scene_root);
 	}
 
+	_update_script_overrides();
 	_setup();
 	GDVIRTUAL_CALL(_setup);
 }
 
-Ref<BTTask> BTTask::clone() const {
-	if (!data.enabled && !Engine::get_singleton()->is_editor_hint()) {
-		return nullptr;
+bool BTTask::is_thread_safe() const {
+	Ref<Script> sc = GET_SCRIPT(this);
+	if (sc.is_null()) {
+		return _is_thread_safe();
 	}
+	// * Scripts must opt in explicitly, whatever the native base class.
+	bool ret = false;
+	GDVIRTUAL_CALL(_is_thread_safe, ret);
+	return ret;
+}
 
-	Ref<BTTask> inst = duplicate(false);
+bool BTTask::is_reusable() const {
+	Ref<Script> sc = GET_SCRIPT(this);
+	if (sc.is_null()) {
+		return _is_reusable();
+	}
+	// * Script members aren't reset by abort(), so scripts must opt in as well.
+	bool ret = false;
+	GDVIRTUAL_CALL(_is_reusable, ret);
+	return ret;
+}
 
-	// * Children are duplicated via children property. See _set_children().
+void BTTask::_update_script_overrides() {
+	uint8_t overrides = 0;
+	if (GDVIRTUAL_IS_OVERRIDDEN(_enter)) {
+		overrides |= SCRIPT_OVERRIDES_ENTER;
+	}
+	if (GDVIRTUAL_IS_OVERRIDDEN(_tick)) {
+		overrides |= SCRIPT_OVERRIDES_TICK;
+	}
+	if (GDVIRTUAL_IS_OVERRIDDEN(_exit)) {
+		overrides |= SCRIPT_OVERRIDES_EXIT;
+	}
+	data.script_overrides = overrides;
+	data.pass_through = !(overrides & SCRIPT_OVERRIDES_TICK) && _is_pass_through();
+}
 
-	// * Make BBParam properties unique.
-	HashMap<Ref<Resource>, Ref<Resource>> duplicates;
+struct BTTask::ClonePlans {
+#ifdef LIMBOAI_MODULE
+	Mutex mutex;
+#elif LIMBOAI_GDEXTENSION
+	Ref<Mutex> mutex;
+#endif
+	HashMap<StringName, LocalVector<StringName>> native; // By class name.
+	HashMap<uint64_t, LocalVector<StringName>> scripted; // By script instance ID.
+};
+
+BTTask::ClonePlans *BTTask::clone_plans = nullptr;
+
+void BTTask::initialize_clone_plans() {
+	clone_plans = memnew(ClonePlans);
+#ifdef LIMBOAI_GDEXTENSION
+	clone_plans->mutex.instantiate();
+#endif
+}
+
+void BTTask::finalize_clone_plans() {
+	if (clone_plans) {
+		memdelete(clone_plans);
+		clone_plans = nullptr;
+	}
+}
+
+// Returns false if the property can't ever hold a BBParam, judging by its declared type.
+static bool _can_hold_bb_param(const PropertyInfo &p_prop) {
+	if (!(p_prop.usage & PROPERTY_USAGE_STORAGE)) {
+		return false;
+	}
+	switch (p_prop.type) {
+		case Variant::NIL: {
+			return true; // Variant.
+		}
+		case Variant::OBJECT: {
+			if (p_prop.hint != PROPERTY_HINT_RESOURCE_TYPE || p_prop.hint_string.is_empty()) {
+				return true;
+			}
+			PackedStringArray classes = String(p_prop.hint_string).split(",");
+			for (int i = 0; i < classes.size(); i++) {
+				StringName cls = classes[i].strip_edges();
+				// * Script classes aren't known to ClassDB, so they are always inspected.
+				if (!ClassDB::class_exists(cls) ||
+						ClassDB::is_parent_class(cls, LW_NAME(BBParam)) ||
+						ClassDB::is_parent_class(LW_NAME(BBParam), cls)) {
+					return true;
+				}
+			}
+			return false;
+		}
+		case Variant::ARRAY: {
+			// * Children are duplicated via children property. See _set_children().
+			return String(p_prop.name) != "children";
+		}
+		default: {
+			return false;
+		}
+	}
+}
+
+LocalVector<StringName> BTTask::_make_clone_plan(BTTask *p_task) {
+	LocalVector<StringName> plan;
 #ifdef LIMBOAI_MODULE
 	List<PropertyInfo> props;
-	inst->get_property_list(&props);
+	p_task->get_property_list(&props);
 	for (List<PropertyInfo>::Element *E = props.front(); E; E = E->next()) {
-		PropertyInfo prop = E->get();
+		const PropertyInfo &prop = E->get();
 #elif LIMBOAI_GDEXTENSION
-	TypedArray<Dictionary> props = inst->get_property_list();
+	TypedArray<Dictionary> props = p_task->get_property_list();
 	for (int i = 0; i < props.size(); i++) {
 		PropertyInfo prop = PropertyInfo::from_dict(props[i]);
 #endif
-		if (!(prop.usage & PROPERTY_USAGE_STORAGE)) {
-			continue;
+		if (_can_hold_bb_param(prop)) {
+			plan.push_back(prop.name);
 		}
+	}
+	return plan;
+}
 
-		Variant prop_value = inst->get(prop.name);
-		Ref<Resource> res = prop_value;
-		if (res.is_valid() && res->is_class("BBParam")) {
-			// Duplicate BBParam
-			if (!duplicates.has(res)) {
-				duplicates[res] = res->duplicate();
+const LocalVector<StringName> *BTTask::_get_clone_plan(BTTask *p_task) {
+	// * In the editor, scripts and their exported properties may change at any time.
+	if (clone_plans == nullptr || Engine::get_singleton()->is_editor_hint()) {
+		return nullptr;
+	}
+
+	Ref<Script> task_script = p_task->get_script();
+	const uint64_t script_id = task_script.is_valid() ? uint64_t(task_script->get_instance_id()) : 0;
+	const StringName class_name = script_id ? StringName() : StringName(p_task->get_class());
+
+	{
+#ifdef LIMBOAI_MODULE
+		MutexLock lock(clone_plans->mutex);
+#elif LIMBOAI_GDEXTENSION
+		MutexLock lock(*clone_plans->mutex.ptr());
+#endif
+		LocalVector<StringName> *plan = script_id ? clone_plans->scripted.getptr(script_id) : clone_plans->native.getptr(class_name);
+		if (plan) {
+			return plan;
+		}
+	}
+
+	// * Computed outside the lock, since it may call into the script.
+	LocalVector<StringName> new_plan = _make_clone_plan(p_task);
+
+#ifdef LIMBOAI_MODULE
+	MutexLock lock(clone_plans->mutex);
+#elif LIMBOAI_GDEXTENSION
+	MutexLock lock(*clone_plans->mutex.ptr());
+#endif
+	// * HashMap elements are never relocated, so the returned pointer stays valid until finalize_clone_plans().
+	if (script_id) {
+		if (!clone_plans->scripted.has(script_id)) {
+			clone_plans->scripted.insert(script_id, new_plan);
+		}
+		return clone_plans->scripted.getptr(script_id);
+	} else {
+		if (!clone_plans->native.has(class_name)) {
+			clone_plans->native.insert(class_name, new_plan);
+		}
+		return clone_plans->native.getptr(class_name);
+	}
+}
+
+// Returns true if the BBParam is immutable at runtime: it holds a saved value, has no script attached,
+// and isn't marked as local to scene (which requests a unique copy per instance).
+static bool _is_constant_bb_param(const Ref<Resource> &p_param) {
+	const BBParam *param = Object::cast_to<BBParam>(p_param.ptr());
+	return param != nullptr &&
+			param->get_value_source() == BBParam::SAVED_VALUE &&
+			!Ref<Script>(param->get_script()).is_valid() &&
+			!param->is_local_to_scene();
+}
+
+Ref<BTTask> BTTask::clone() const {
+	if (!data.enabled && !Engine::get_singleton()->is_editor_hint()) {
+		return nullptr;
+	}
+
+	Ref<BTTask> inst = duplicate(false);
+
+	// * Children are duplicated via children property. See _set_children().
+
+	// * Make BBParam properties unique.
+	// * Only the properties listed in the clone plan of this task's class or script are inspected.
+	LocalVector<StringName> uncached_plan;
+	const LocalVector<StringName> *plan = _get_clone_plan(inst.ptr());
+	if (plan == nullptr) {
+		uncached_plan = _make_clone_plan(inst.ptr());
+		plan = &uncached_plan;
+	}
+
+	// * Clones of a runtime prototype share its constant BBParams, as the prototype itself is never executed.
+	// * The prototype, in turn, got its own copies when it was cloned from the resource.
+	// * Script tasks may modify their params, so these are always duplicated.
+	const bool share_constants = data.prototype && !Ref<Script>(inst->get_script()).is_valid();
+
+	HashMap<Ref<Resource>, Ref<Resource>> duplicates;
+	for (const StringName &prop_name : *plan) {
+		Variant prop_value = inst->get(prop_name);
+		if (prop_value.get_type() == Variant::OBJECT) {
+			Ref<Resource> res = prop_value;
+			if (res.is_valid() && res->is_class("BBParam")) {
+				if (share_constants && _is_constant_bb_param(res)) {
+					continue;
+				}
+				// Duplicate BBParam
+				if (!duplicates.has(res)) {
+					duplicates[res] = res->duplicate();
+				}
+				res = duplicates[res];
+				inst->set(prop_name, res);
 			}
-			res = duplicates[res];
-			inst->set(prop.name, res);
 		} else if (prop_value.get_type() == Variant::ARRAY) {
 			// Duplicate BBParams instances inside an array.
 			// - This code doesn't handle arrays of arrays.
@@ -231,7 +427,7 @@ Ref<BTTask> BTTask::clone() const {
 			if (arr.is_typed() && ClassDB::is_parent_class(arr.get_typed_class_name(), LW_NAME(BBParam))) {
 				for (int j = 0; j < arr.size(); j++) {
 					Ref<Resource> bb_param = arr[j];
-					if (bb_param.is_valid()) {
+					if (bb_param.is_valid() && !(share_constants && _is_constant_bb_param(bb_param))) {
 						arr[j] = bb_param->duplicate();
 					}
 				}
@@ -242,28 +438,84 @@ Ref<BTTask> BTTask::clone() const {
 	return inst;
 }
 
+void BTTask::_invalidate_compiled() {
+	if (data.compiled_tree) {
+		data.compiled_tree->mark_dirty();
+	}
+}
+
+void BTTask::_add_deferred_child(const Ref<BTTask> &p_child) {
+	if (data.compiled_tree) {
+		data.compiled_tree->mark_dirty(true);
+	}
+	add_child(p_child);
+}
+
+void BTTask::_abort_children() {
+	if (data.compiled_tree) {
+		// Walk siblings in the flat layout: children are visited in the same order as in the hierarchy.
+		const BTCompiledTree::Node *nodes = data.compiled_tree->ptr();
+		BTTask *const *tasks = data.compiled_tree->tasks_ptr();
+		const int end = nodes[data.compiled_index].subtree_end;
+		for (int i = data.compiled_index + 1; i < end; i = nodes[i].subtree_end) {
+			tasks[i]->abort();
+		}
+	} else {
+		for (int i = 0; i < data.children.size(); i++) {
+			data.children[i]->abort();
+		}
+	}
+}
+
 BT::Status BTTask::execute(double p_delta) {
+	if (unlikely(data.resume_latched)) {
+		// Already executed during this update, see BTInstance::set_resume_at_running_task().
+		data.resume_latched = false;
+		return data.status;
+	}
+
 	if (data.status != RUNNING) {
 		// Reset children status.
 		if (data.status != FRESH) {
-			for (int i = 0; i < get_child_count(); i++) {
-				data.children.get(i)->abort();
-			}
+			_abort_children();
 		}
 		// First native, then script.
 		_enter();
-		GDVIRTUAL_CALL(_enter);
+		if (data.script_overrides & SCRIPT_OVERRIDES_ENTER) {
+			GDVIRTUAL_CALL(_enter);
+		}
 	} else {
 		data.elapsed += p_delta;
+		if (unlikely(data.pass_through && data.compiled_tree && data.compiled_tree->has_suspended())) {
+			// The running path below ends at a suspended task: ticking it would only pass RUNNING back up.
+			const int sleeping = data.compiled_tree->find_sleeping_index(data.compiled_index);
+			if (sleeping != -1) {
+				data.compiled_tree->add_elapsed_to_path(sleeping, data.compiled_index, p_delta);
+				return RUNNING;
+			}
+		}
 	}
 
-	if (!GDVIRTUAL_CALL(_tick, p_delta, data.status)) {
-		data.status = _tick(p_delta);
+	if (unlikely(data.suspended)) {
+		// Not ticked until resumed, see suspend().
+		data.status = RUNNING;
+		return RUNNING;
 	}
 
+	Status status;
+	if (!(data.script_overrides & SCRIPT_OVERRIDES_TICK) || !GDVIRTUAL_CALL(_tick, p_delta, status)) {
+		status = _tick(p_delta);
+	}
+	data.status = status;
+
 	if (data.status != RUNNING) {
+		if (unlikely(data.suspended)) {
+			resume();
+		}
 		// First script, then native.
-		GDVIRTUAL_CALL(_exit);
+		if (data.script_overrides & SCRIPT_OVERRIDES_EXIT) {
+			GDVIRTUAL_CALL(_exit);
+		}
 		_exit();
 		data.elapsed = 0.0;
 	}
@@ -271,18 +523,116 @@ BT::Status BTTask::execute(double p_delta) {
 }
 
 void BTTask::abort() {
-	for (int i = 0; i < data.children.size(); i++) {
-		get_child(i)->abort();
+	data.resume_latched = false;
+	if (data.suspended) {
+		resume();
 	}
+	_abort_children();
 	if (data.status == RUNNING) {
 		// First script, then native.
-		GDVIRTUAL_CALL(_exit);
+		if (data.script_overrides & SCRIPT_OVERRIDES_EXIT) {
+			GDVIRTUAL_CALL(_exit);
+		}
 		_exit();
 	}
 	data.status = FRESH;
 	data.elapsed = 0.0;
 }
 
+void BTTask::suspend() {
+	if (data.suspended) {
+		return;
+	}
+	data.suspended = true;
+	if (data.compiled_tree) {
+		data.compiled_tree->notify_suspended(true);
+	}
+}
+
+static int _get_signal_argument_count(const Signal &p_signal) {
+	Object *obj = p_signal.get_object();
+#ifdef LIMBOAI_MODULE
+	List<MethodInfo> signals;
+	obj->get_signal_list(&signals);
+	for (const MethodInfo &mi : signals) {
+		if (mi.name == p_signal.get_name()) {
+			return mi.arguments.size();
+		}
+	}
+#elif LIMBOAI_GDEXTENSION
+	TypedArray<Dictionary> signals = obj->get_signal_list();
+	for (int i = 0; i < signals.size(); i++) {
+		Dictionary mi = signals[i];
+		if (StringName(mi["name"]) == p_signal.get_name()) {
+			return Array(mi["args"]).size();
+		}
+	}
+#endif
+	return 0;
+}
+
+void BTTask::suspend_until(const Signal &p_signal) {
+	ERR_FAIL_COND_MSG(p_signal.is_null() || p_signal.get_object() == nullptr, "BTTask: Can't suspend until an invalid signal.");
+	// * Signal arguments are dropped, as resume() takes none.
+	ColdData::WakeCondition wake;
+	wake.signal = p_signal;
+	wake.callable = callable_mp(this, &BTTask::resume).unbind(_get_signal_argument_count(p_signal));
+	ERR_FAIL_COND(wake.signal.is_connected(wake.callable));
+	wake.signal.connect(wake.callable);
+	_get_cold()->wake_conditions.push_back(wake);
+	suspend();
+}
+
+void BTTask::suspend_for(double p_seconds) {
+	ERR_FAIL_NULL_MSG(get_agent(), "BTTask: Can't suspend for a duration before the task is initialized.");
+	ERR_FAIL_COND_MSG(!get_agent()->is_inside_tree(), "BTTask: Can't suspend for a duration while the agent is outside the scene tree.");
+	Ref<SceneTreeTimer> timer = get_agent()->get_tree()->create_timer(p_seconds);
+	suspend_until(Signal(timer.ptr(), LW_NAME(timeout)));
+}
+
+void BTTask::_on_wake_var_changed(void *p_userdata, const StringName &p_name, const Variant &p_value) {
+	static_cast<BTTask *>(p_userdata)->resume();
+}
+
+void BTTask::suspend_until_var_changed(const StringName &p_var) {
+	ERR_FAIL_COND_MSG(get_blackboard().is_null(), "BTTask: Can't suspend until a variable changes before the task is initialized.");
+	ColdData::WakeCondition wake;
+	wake.blackboard = get_blackboard();
+	wake.observer_id = wake.blackboard->observe_var(p_var, &BTTask::_on_wake_var_changed, this);
+	ERR_FAIL_COND(wake.observer_id == 0);
+	_get_cold()->wake_conditions.push_back(wake);
+	suspend();
+}
+
+void BTTask::resume() {
+	if (!data.suspended) {
+		return;
+	}
+	_clear_wake_conditions();
+	data.suspended = false;
+	if (data.compiled_tree) {
+		data.compiled_tree->notify_suspended(false);
+	}
+}
+
+void BTTask::_clear_wake_conditions() {
+	if (data.cold == nullptr) {
+		return;
+	}
+	for (ColdData::WakeCondition &wake : data.cold->wake_conditions) {
+		if (wake.observer_id != 0) {
+			// * Safe to call while the observers are being notified, see Blackboard::remove_observer().
+			wake.blackboard->remove_observer(wake.observer_id);
+			continue;
+		}
+		// * The emitter, such as a SceneTreeTimer, may be gone already.
+		if (wake.signal.get_object() && wake.signal.is_connected(wake.callable)) {
+			wake.signal.disconnect(wake.callable);
+		}
+	}
+	data.cold->wake_conditions.clear();
+}
+
 int BTTask::get_enabled_child_count() const {
 	int count = 0;
 	for (int i = 0; i < data.children.size(); i++) {
@@ -295,6 +645,7 @@ int BTTask::get_enabled_child_count() const {
 
 void BTTask::add_child(Ref<BTTask> p_child) {
 	ERR_FAIL_COND_MSG(p_child->get_parent().is_valid(), "p_child already has a parent!");
+	_invalidate_compiled();
 	p_child->data.parent = this;
 	p_child->data.index = data.children.size();
 	data.children.push_back(p_child);
@@ -306,6 +657,7 @@ void BTTask::add_child_at_index(Ref<BTTask> p_child, int p_idx) {
 	if (p_idx < 0 || p_idx > data.children.size()) {
 		p_idx = data.children.size();
 	}
+	_invalidate_compiled();
 	p_child->data.parent = this;
 	p_child->data.index = p_idx;
 	data.children.insert(p_idx, p_child);
@@ -318,6 +670,7 @@ void BTTask::add_child_at_index(Ref<BTTask> p_child, int p_idx) {
 void BTTask::remove_child(Ref<BTTask> p_child) {
 	int idx = data.children.find(p_child);
 	ERR_FAIL_COND_MSG(idx == -1, "p_child not found!");
+	_invalidate_compiled();
 	data.children.remove_at(idx);
 	p_child->data.parent = nullptr;
 	p_child->data.index = -1;
@@ -329,6 +682,7 @@ void BTTask::remove_child(Ref<BTTask> p_child) {
 
 void BTTask::remove_child_at_index(int p_idx) {
 	ERR_FAIL_INDEX(p_idx, get_child_count());
+	_invalidate_compiled();
 	data.children[p_idx]->data.parent = nullptr;
 	data.children[p_idx]->data.index = -1;
 	data.children.remove_at(p_idx);
@@ -392,10 +746,13 @@ void BTTask::print_tree(int p_initial_tabs) {
 Ref<BehaviorTree> BTTask::editor_get_behavior_tree() {
 #ifdef TOOLS_ENABLED
 	BTTask *task = this;
-	while (task->data.behavior_tree_id.is_null() && task->get_parent().is_valid()) {
+	while ((task->data.cold == nullptr || task->data.cold->behavior_tree_id.is_null()) && task->get_parent().is_valid()) {
 		task = task->data.parent;
 	}
-	return Object::cast_to<BehaviorTree>(ObjectDB::get_instance(task->data.behavior_tree_id));
+	if (task->data.cold == nullptr) {
+		return Ref<BehaviorTree>();
+	}
+	return Object::cast_to<BehaviorTree>(ObjectDB::get_instance(task->data.cold->behavior_tree_id));
 #else
 	ERR_PRINT("BTTask::editor_get_behavior_tree: Not available in release builds.");
 	return Ref<BehaviorTree>();
@@ -405,7 +762,7 @@ Ref<BehaviorTree> BTTask::editor_get_behavior_tree() {
 #ifdef TOOLS_ENABLED
 
 void BTTask::editor_set_behavior_tree(const Ref<BehaviorTree> &p_bt) {
-	data.behavior_tree_id = p_bt->get_instance_id();
+	_get_cold()->behavior_tree_id = p_bt->get_instance_id();
 }
 
 #endif // TOOLS_ENABLED
@@ -431,6 +788,12 @@ void BTTask::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("print_tree", "initial_tabs"), &BTTask::print_tree, Variant(0));
 	ClassDB::bind_method(D_METHOD("get_task_name"), &BTTask::get_task_name);
 	ClassDB::bind_method(D_METHOD("abort"), &BTTask::abort);
+	ClassDB::bind_method(D_METHOD("suspend"), &BTTask::suspend);
+	ClassDB::bind_method(D_METHOD("suspend_until", "signal"), &BTTask::suspend_until);
+	ClassDB::bind_method(D_METHOD("suspend_for", "seconds"), &BTTask::suspend_for);
+	ClassDB::bind_method(D_METHOD("suspend_until_var_changed", "var"), &BTTask::suspend_until_var_changed);
+	ClassDB::bind_method(D_METHOD("resume"), &BTTask::resume);
+	ClassDB::bind_method(D_METHOD("is_suspended"), &BTTask::is_suspended);
 	ClassDB::bind_method(D_METHOD("editor_get_behavior_tree"), &BTTask::editor_get_behavior_tree);
 
 #ifndef DISABLE_DEPRECATED
@@ -470,12 +833,22 @@ void BTTask::_bind_methods() {
 	GDVIRTUAL_BIND(_tick, "delta");
 	GDVIRTUAL_BIND(_generate_name);
 	GDVIRTUAL_BIND(_get_configuration_warnings);
+	GDVIRTUAL_BIND(_is_thread_safe);
+	GDVIRTUAL_BIND(_is_reusable);
 }
 
 BTTask::BTTask() {
 }
 
 BTTask::~BTTask() {
+	if (data.compiled_tree) {
+		// * Don't leave a dangling task (or its suspension) in the compiled tree.
+		data.compiled_tree->mark_dirty();
+	}
+	if (data.cold) {
+		_clear_wake_conditions();
+		memdelete(data.cold);
+	}
 	for (int i = 0; i < get_child_count(); i++) {
 		ERR_FAIL_COND(!get_child(i).is_valid());
 		get_child(i)->data.parent = nullptr;
@@ -18,6 +18,7 @@
 #ifdef LIMBOAI_MODULE
 #include "core/io/resource.h"
 #include "core/object/object.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/vector.h"
 #include "scene/main/node.h"
 #endif // LIMBOAI_MODULE
@@ -27,11 +28,13 @@
 #include <godot_cpp/classes/resource.hpp>
 #include <godot_cpp/core/gdvirtual.gen.inc>
 #include <godot_cpp/core/object.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
 #include <godot_cpp/templates/vector.hpp>
 using namespace godot;
 #endif // LIMBOAI_GDEXTENSION
 
 class BehaviorTree;
+class BTCompiledTree;
 
 /**
  * Base class for BTTask.
@@ -60,35 +63,90 @@ class BTTask : public BT {
 
 private:
 	friend class BehaviorTree;
+	friend class BTCompiledTree;
+	friend class BTInstance;
+
+	// Virtual methods implemented by the attached script, cached in initialize().
+	enum ScriptOverride : uint8_t {
+		SCRIPT_OVERRIDES_ENTER = 1 << 0,
+		SCRIPT_OVERRIDES_TICK = 1 << 1,
+		SCRIPT_OVERRIDES_EXIT = 1 << 2,
+		SCRIPT_OVERRIDES_ALL = SCRIPT_OVERRIDES_ENTER | SCRIPT_OVERRIDES_TICK | SCRIPT_OVERRIDES_EXIT,
+	};
+
+	// Rarely accessed fields, allocated on first write. See _get_cold().
+	struct ColdData {
+		String custom_name;
+		bool display_collapsed = false;
+		// Signals or blackboard observers that resume a suspended task, see suspend_until().
+		struct WakeCondition {
+			Signal signal;
+			Callable callable;
+			Ref<Blackboard> blackboard; // Set for suspend_until_var_changed().
+			uint64_t observer_id = 0;
+		};
+		LocalVector<WakeCondition> wake_conditions;
+#ifdef TOOLS_ENABLED
+		ObjectID behavior_tree_id;
+#endif
+	};
 
 	// Avoid namespace pollution in the derived classes.
+	// Fields are ordered by access frequency: the ones read by every execute() come first,
+	// so that they share a cache line.
 	struct Data {
+		// Hot: execute(), abort() and the composites' child loops.
+		Status status = FRESH;
+		double elapsed = 0.0;
+		Vector<Ref<BTTask>> children;
+		BTCompiledTree *compiled_tree = nullptr;
+		int compiled_index = -1;
+		bool enabled = true;
+		uint8_t script_overrides = SCRIPT_OVERRIDES_ALL; // Until initialized, assume everything is overridden.
+		bool pass_through = false; // Cached _is_pass_through(), see initialize().
+		bool resume_latched = false; // Already executed this tick by BTInstance, see execute().
+		bool suspended = false; // See suspend().
+
+		// Warm: accessed by task implementations and tree traversal.
+		BTTask *parent = nullptr;
 		int index = -1;
-		String custom_name;
+		bool prototype = false; // Part of BehaviorTree's runtime prototype, see clone().
 		Node *agent = nullptr;
 		Node *scene_root = nullptr;
 		Ref<Blackboard> blackboard;
-		BTTask *parent = nullptr;
-		Vector<Ref<BTTask>> children;
-		Status status = FRESH;
-		double elapsed = 0.0;
-		bool display_collapsed = false;
-		bool enabled = true;
-#ifdef TOOLS_ENABLED
-		ObjectID behavior_tree_id;
-#endif
+
+		// Cold: editor and diagnostics only.
+		ColdData *cold = nullptr;
 	} data;
 
+	ColdData *_get_cold();
+	void _clear_wake_conditions();
+	static void _on_wake_var_changed(void *p_userdata, const StringName &p_name, const Variant &p_value);
+
 	Array _get_children() const;
 	void _set_children(Array children);
 
 	PackedStringArray _get_configuration_warnings(); // ! Scripts only.
 
+	void _update_script_overrides();
+	void _abort_children();
+	void _invalidate_compiled();
+
+	// Names of the storage properties that clone() must inspect for BBParam values.
+	// Computed once per native class or attached script, see _get_clone_plan().
+	struct ClonePlans;
+	static ClonePlans *clone_plans;
+	static LocalVector<StringName> _make_clone_plan(BTTask *p_task);
+	static const LocalVector<StringName> *_get_clone_plan(BTTask *p_task);
+
 protected:
 	static void _bind_methods();
 
 	void _set_enabled(bool p_enabled) { data.enabled = p_enabled; }
 	void _emit_branch_changed();
+	// Adds a child that belongs to the prototype but is created on demand, see BTSubtree::lazy.
+	// Unlike add_child(), this keeps the instance reusable by BTInstancePool.
+	void _add_deferred_child(const Ref<BTTask> &p_child);
 
 	virtual String _generate_name();
 	virtual void _setup() {}
@@ -96,12 +154,29 @@ protected:
 	virtual void _exit() {}
 	virtual Status _tick(double p_delta) { return FAILURE; }
 
+	// Return true if, while RUNNING, _tick() does nothing but execute the one running child
+	// and return RUNNING whenever that child does. BTInstance can then skip such tasks and
+	// resume execution directly at their running descendant.
+	virtual bool _is_pass_through() const { return false; }
+
+	// Return true if the task can execute on a worker thread: it must not access the scene
+	// tree, emit signals, or touch any state shared with other instances. Blackboard access is
+	// allowed, as instances with shared blackboard variables are updated on the main thread,
+	// see BTInstance::is_thread_safe(). Scripts must opt in by overriding this method.
+	virtual bool _is_thread_safe() const { return false; }
+
+	// Return true if abort() followed by initialize() leaves the task as good as a fresh clone,
+	// i.e. the task keeps no state across runs. Only such trees are reused by BTInstancePool.
+	virtual bool _is_reusable() const { return false; }
+
 	GDVIRTUAL0RC(String, _generate_name);
 	GDVIRTUAL0(_setup);
 	GDVIRTUAL0(_enter);
 	GDVIRTUAL0(_exit);
 	GDVIRTUAL1R(Status, _tick, double);
 	GDVIRTUAL0RC(PackedStringArray, _get_configuration_warnings);
+	GDVIRTUAL0RC(bool, _is_thread_safe);
+	GDVIRTUAL0RC(bool, _is_reusable);
 
 #ifdef LIMBOAI_GDEXTENSION
 	String _to_string() const { return "<" + get_class() + "#" + itos(get_instance_id()) + ">"; }
@@ -127,7 +202,7 @@ public:
 	void set_display_collapsed(bool p_display_collapsed);
 	bool is_displayed_collapsed() const;
 
-	String get_custom_name() const { return data.custom_name; }
+	String get_custom_name() const { return data.cold ? data.cold->custom_name : String(); }
 	void set_custom_name(const String &p_name);
 	String get_task_name();
 
@@ -136,10 +211,21 @@ public:
 	virtual Ref<BTTask> clone() const;
 	virtual void initialize(Node *p_agent, const Ref<Blackboard> &p_blackboard, Node *p_scene_root);
 	virtual PackedStringArray get_configuration_warnings(); // ! Native version.
+	bool is_thread_safe() const;
+	bool is_reusable() const;
 
 	Status execute(double p_delta);
 	void abort();
 
+	// Suspended tasks remain RUNNING, but aren't ticked until resumed. If all of the running
+	// path is suspended, BTInstance skips its updates altogether, see BTInstance::is_suspended().
+	void suspend();
+	void suspend_until(const Signal &p_signal);
+	void suspend_for(double p_seconds);
+	void suspend_until_var_changed(const StringName &p_var);
+	void resume();
+	_FORCE_INLINE_ bool is_suspended() const { return data.suspended; }
+
 	_FORCE_INLINE_ Ref<BTTask> get_parent() const { return Ref<BTTask>(data.parent); }
 	_FORCE_INLINE_ bool is_root() const { return data.parent == nullptr; }
 	_FORCE_INLINE_ Ref<Blackboard> get_blackboard() const { return data.blackboard; }
@@ -151,6 +237,13 @@ public:
 		return data.children.get(p_idx);
 	}
 
+	// Non-owning alternative to get_child() for the tick path, which avoids reference counting.
+	// The child is kept alive by this task, so it must not be removed while it's executing.
+	_FORCE_INLINE_ BTTask *get_child_ptr(int p_idx) const {
+		ERR_FAIL_INDEX_V(p_idx, data.children.size(), nullptr);
+		return data.children[p_idx].ptr();
+	}
+
 	_FORCE_INLINE_ int get_child_count() const { return data.children.size(); }
 	int get_enabled_child_count() const;
 
@@ -172,6 +265,9 @@ public:
 	void editor_set_behavior_tree(const Ref<BehaviorTree> &p_bt);
 #endif
 
+	static void initialize_clone_plans();
+	static void finalize_clone_plans();
+
 	BTTask();
 	~BTTask();
 };
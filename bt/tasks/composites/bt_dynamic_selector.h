@@ -12,6 +12,7 @@
 #ifndef BT_DYNAMIC_SELECTOR_H
 #define BT_DYNAMIC_SELECTOR_H
 
+#include "../../../blackboard/bb_read_tracker.h"
 #include "../bt_composite.h"
 
 class BTDynamicSelector : public BTComposite {
@@ -20,12 +21,26 @@ class BTDynamicSelector : public BTComposite {
 
 private:
 	int last_running_idx = 0;
+	bool observe_blackboard = false;
+
+	// Blackboard variables read by the children preceding the current runner.
+	BBReadTracker guard_reads;
+	bool guards_valid = false;
 
 protected:
-	static void _bind_methods() {}
+	static void _bind_methods();
 
 	virtual void _enter() override;
 	virtual Status _tick(double p_delta) override;
+	virtual bool _is_thread_safe() const override { return true; }
+	virtual bool _is_reusable() const override { return true; }
+
+public:
+	void set_observe_blackboard(bool p_enable) {
+		observe_blackboard = p_enable;
+		emit_changed();
+	}
+	bool get_observe_blackboard() const { return observe_blackboard; }
 };
 
 #endif // BT_DYNAMIC_SELECTOR_H
@@ -13,22 +13,55 @@
 
 void BTDynamicSequence::_enter() {
 	last_running_idx = 0;
+	guards_valid = false;
+	guard_reads.clear();
 }
 
 BT::Status BTDynamicSequence::_tick(double p_delta) {
+	int start = 0;
+	if (observe_blackboard) {
+		if (guards_valid && !guard_reads.has_changes()) {
+			// * Preceding children read nothing that changed since they were evaluated - skip to the runner.
+			guard_reads.forward();
+			start = last_running_idx;
+		} else {
+			guard_reads.clear();
+		}
+	}
+
 	Status status = SUCCESS;
 	int i;
-	for (i = 0; i < get_child_count(); i++) {
-		status = get_child(i)->execute(p_delta);
-		if (status != SUCCESS) {
-			break;
+	for (i = start; i < get_child_count(); i++) {
+		if (observe_blackboard) {
+			const int num_guard_reads = guard_reads.size();
+			guard_reads.begin();
+			status = get_child_ptr(i)->execute(p_delta);
+			guard_reads.end();
+			if (status != SUCCESS) {
+				// * Reads of the last executed child are not guarding anything.
+				guard_reads.truncate(num_guard_reads);
+				break;
+			}
+		} else {
+			status = get_child_ptr(i)->execute(p_delta);
+			if (status != SUCCESS) {
+				break;
+			}
 		}
 	}
 	// If the last node ticked is earlier in the tree than the previous runner,
 	// cancel previous runner.
-	if (last_running_idx > i && get_child(last_running_idx)->get_status() == RUNNING) {
-		get_child(last_running_idx)->abort();
+	if (last_running_idx > i && get_child_ptr(last_running_idx)->get_status() == RUNNING) {
+		get_child_ptr(last_running_idx)->abort();
 	}
 	last_running_idx = i;
+	guards_valid = observe_blackboard && status == RUNNING;
 	return status;
 }
+
+void BTDynamicSequence::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("set_observe_blackboard", "enable"), &BTDynamicSequence::set_observe_blackboard);
+	ClassDB::bind_method(D_METHOD("get_observe_blackboard"), &BTDynamicSequence::get_observe_blackboard);
+
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "observe_blackboard"), "set_observe_blackboard", "get_observe_blackboard");
+}
@@ -12,24 +12,35 @@
 #include "bt_parallel.h"
 
 void BTParallel::_enter() {
+	running_children.clear();
 	for (int i = 0; i < get_child_count(); i++) {
-		get_child(i)->abort();
+		get_child_ptr(i)->abort();
+		running_children.push_back(i);
 	}
+	num_succeeded = 0;
+	num_failed = 0;
 }
 
 BT::Status BTParallel::_tick(double p_delta) {
-	int num_succeeded = 0;
-	int num_failed = 0;
-	BT::Status return_status = RUNNING;
-	for (int i = 0; i < get_child_count(); i++) {
-		Status status = BT::FRESH;
-		Ref<BTTask> child = get_child(i);
-		if (!repeat && (child->get_status() == FAILURE || child->get_status() == SUCCESS)) {
-			status = child->get_status();
-		} else {
-			status = child->execute(p_delta);
+	if (repeat) {
+		running_children.clear();
+		for (int i = 0; i < get_child_count(); i++) {
+			running_children.push_back(i);
 		}
-		if (status == FAILURE) {
+		num_succeeded = 0;
+		num_failed = 0;
+	}
+
+	BT::Status return_status = RUNNING;
+	uint32_t num_running = 0;
+	for (uint32_t i = 0; i < running_children.size(); i++) {
+		const int idx = running_children[i];
+		Status status = get_child_ptr(idx)->execute(p_delta);
+		if (status == RUNNING) {
+			// * Keep it, preserving the order.
+			running_children[num_running] = idx;
+			num_running += 1;
+		} else if (status == FAILURE) {
 			num_failed += 1;
 			if (num_failed >= num_failures_required && return_status == RUNNING) {
 				return_status = FAILURE;
@@ -41,7 +52,9 @@ BT::Status BTParallel::_tick(double p_delta) {
 			}
 		}
 	}
-	if (!repeat && (num_failed + num_succeeded) == get_child_count() && return_status == RUNNING) {
+	running_children.resize(num_running);
+
+	if (!repeat && running_children.is_empty() && return_status == RUNNING) {
 		return_status = FAILURE;
 	}
 	return return_status;
@@ -23,11 +23,19 @@ private:
 	int num_failures_required = 1;
 	bool repeat = false;
 
+	// Children still running in the current execution, in order, and the number of finished ones.
+	// If repeat is enabled, all children are executed and counted anew on every tick.
+	LocalVector<int> running_children;
+	int num_succeeded = 0;
+	int num_failed = 0;
+
 protected:
 	static void _bind_methods();
 
 	virtual void _enter() override;
 	virtual Status _tick(double p_delta) override;
+	virtual bool _is_thread_safe() const override { return true; }
+	virtual bool _is_reusable() const override { return true; }
 
 public:
 	int get_num_successes_required() const { return num_successes_required; }
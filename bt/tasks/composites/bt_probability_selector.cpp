@@ -15,19 +15,19 @@
 
 double BTProbabilitySelector::get_weight(int p_index) const {
 	ERR_FAIL_INDEX_V(p_index, get_child_count(), 0.0);
-	ERR_FAIL_COND_V(!get_child(p_index)->is_enabled(), 0.0);
+	ERR_FAIL_COND_V(!get_child_ptr(p_index)->is_enabled(), 0.0);
 	return _get_weight(p_index);
 }
 
 void BTProbabilitySelector::set_weight(int p_index, double p_weight) {
 	ERR_FAIL_INDEX(p_index, get_child_count());
-	ERR_FAIL_COND(!get_child(p_index)->is_enabled());
+	ERR_FAIL_COND(!get_child_ptr(p_index)->is_enabled());
 	_set_weight(p_index, p_weight);
 }
 
 double BTProbabilitySelector::get_probability(int p_index) const {
 	ERR_FAIL_INDEX_V(p_index, get_child_count(), 0.0);
-	ERR_FAIL_COND_V(!get_child(p_index)->is_enabled(), 0.0);
+	ERR_FAIL_COND_V(!get_child_ptr(p_index)->is_enabled(), 0.0);
 	double total = _get_total_weight();
 	return total == 0.0 ? 0.0 : _get_weight(p_index) / total;
 }
@@ -36,7 +36,7 @@ void BTProbabilitySelector::set_probability(int p_index, double p_probability) {
 	ERR_FAIL_INDEX(p_index, get_child_count());
 	ERR_FAIL_COND(p_probability < 0.0);
 	ERR_FAIL_COND(p_probability >= 1.0);
-	ERR_FAIL_COND(!get_child(p_index)->is_enabled());
+	ERR_FAIL_COND(!get_child_ptr(p_index)->is_enabled());
 
 	double others_total = _get_total_weight() - _get_weight(p_index);
 	double others_probability = 1.0 - p_probability;
@@ -50,7 +50,7 @@ void BTProbabilitySelector::set_probability(int p_index, double p_probability) {
 
 bool BTProbabilitySelector::has_probability(int p_index) const {
 	ERR_FAIL_INDEX_V(p_index, get_child_count(), false);
-	return get_child(p_index)->is_enabled();
+	return get_child_ptr(p_index)->is_enabled();
 }
 
 void BTProbabilitySelector::set_abort_on_failure(bool p_abort_on_failure) {
@@ -34,7 +34,7 @@ private:
 
 	void _select_task();
 #define SNAME(m_arg) ([]() -> const StringName & { static StringName sname = _scs_create(m_arg, true); return sname; })()
-	_FORCE_INLINE_ double _get_weight(int p_index) const { return get_child(p_index)->get_meta(LW_NAME(_weight_), 1.0); }
+	_FORCE_INLINE_ double _get_weight(int p_index) const { return get_child_ptr(p_index)->get_meta(LW_NAME(_weight_), 1.0); }
 	_FORCE_INLINE_ double _get_weight(Ref<BTTask> p_task) const { return p_task->get_meta(LW_NAME(_weight_), 1.0); }
 	_FORCE_INLINE_ void _set_weight(int p_index, double p_weight) {
 		get_child(p_index)->set_meta(LW_NAME(_weight_), Variant(p_weight));
@@ -43,7 +43,7 @@ private:
 	_FORCE_INLINE_ double _get_total_weight() const {
 		double total = 0.0;
 		for (int i = 0; i < get_child_count(); i++) {
-			if (get_child(i)->is_enabled()) {
+			if (get_child_ptr(i)->is_enabled()) {
 				total += _get_weight(i);
 			}
 		}
@@ -56,6 +56,7 @@ protected:
 	virtual void _enter() override;
 	virtual void _exit() override;
 	virtual Status _tick(double p_delta) override;
+	virtual bool _is_pass_through() const override { return true; }
 
 public:
 	double get_weight(int p_index) const;
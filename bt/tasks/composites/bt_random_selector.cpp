@@ -25,7 +25,7 @@ void BTRandomSelector::_enter() {
 BT::Status BTRandomSelector::_tick(double p_delta) {
 	Status status = FAILURE;
 	for (int i = last_running_idx; i < get_child_count(); i++) {
-		status = get_child(indicies[i])->execute(p_delta);
+		status = get_child_ptr(indicies[i])->execute(p_delta);
 		if (status != FAILURE) {
 			last_running_idx = i;
 			break;
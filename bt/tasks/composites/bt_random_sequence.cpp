@@ -25,7 +25,7 @@ void BTRandomSequence::_enter() {
 BT::Status BTRandomSequence::_tick(double p_delta) {
 	Status status = SUCCESS;
 	for (int i = last_running_idx; i < get_child_count(); i++) {
-		status = get_child(indicies[i])->execute(p_delta);
+		status = get_child_ptr(indicies[i])->execute(p_delta);
 		if (status != SUCCESS) {
 			last_running_idx = i;
 			break;
@@ -27,6 +27,7 @@ protected:
 
 	virtual void _enter() override;
 	virtual Status _tick(double p_delta) override;
+	virtual bool _is_pass_through() const override { return true; }
 };
 
 #endif // BT_RANDOM_SEQUENCE_H
@@ -18,7 +18,7 @@ void BTSelector::_enter() {
 BT::Status BTSelector::_tick(double p_delta) {
 	Status status = FAILURE;
 	for (int i = last_running_idx; i < get_child_count(); i++) {
-		status = get_child(i)->execute(p_delta);
+		status = get_child_ptr(i)->execute(p_delta);
 		if (status != FAILURE) {
 			last_running_idx = i;
 			break;
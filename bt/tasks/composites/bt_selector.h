@@ -26,6 +26,9 @@ protected:
 
 	virtual void _enter() override;
 	virtual Status _tick(double p_delta) override;
+	virtual bool _is_pass_through() const override { return true; }
+	virtual bool _is_thread_safe() const override { return true; }
+	virtual bool _is_reusable() const override { return true; }
 };
 
 #endif // BT_SELECTOR_H
@@ -22,6 +22,9 @@ protected:
 	static void _bind_methods() {}
 
 	virtual Status _tick(double p_delta) override;
+	virtual bool _is_pass_through() const override { return true; }
+	virtual bool _is_thread_safe() const override { return true; }
+	virtual bool _is_reusable() const override { return true; }
 };
 
 #endif // BT_ALWAYS_SUCCEED_H
@@ -38,6 +38,9 @@ void BTCooldown::set_trigger_on_failure(bool p_value) {
 
 void BTCooldown::set_cooldown_state_var(const StringName &p_value) {
 	cooldown_state_var = p_value;
+	if (get_blackboard().is_valid()) {
+		cooldown_state_handle = get_blackboard()->get_var_handle(cooldown_state_var);
+	}
 	emit_changed();
 }
 
@@ -51,7 +54,8 @@ void BTCooldown::_setup() {
 	if (cooldown_state_var == StringName()) {
 		cooldown_state_var = vformat("cooldown_%d", get_instance_id());
 	}
-	get_blackboard()->set_var(cooldown_state_var, false);
+	cooldown_state_handle = get_blackboard()->get_var_handle(cooldown_state_var);
+	get_blackboard()->set_bool_by_handle(cooldown_state_handle, false);
 	if (start_cooled) {
 		_chill();
 	}
@@ -59,10 +63,10 @@ void BTCooldown::_setup() {
 
 BT::Status BTCooldown::_tick(double p_delta) {
 	ERR_FAIL_COND_V_MSG(get_child_count() == 0, FAILURE, "BT decorator has no child.");
-	if (get_blackboard()->get_var(cooldown_state_var, true)) {
+	if (get_blackboard()->get_bool_by_handle(cooldown_state_handle, true)) {
 		return FAILURE;
 	}
-	Status status = get_child(0)->execute(p_delta);
+	Status status = get_child_ptr(0)->execute(p_delta);
 	if (status == SUCCESS || (trigger_on_failure && status == FAILURE)) {
 		_chill();
 	}
@@ -70,7 +74,7 @@ BT::Status BTCooldown::_tick(double p_delta) {
 }
 
 void BTCooldown::_chill() {
-	get_blackboard()->set_var(cooldown_state_var, true);
+	get_blackboard()->set_bool_by_handle(cooldown_state_handle, true);
 	if (timer.is_valid()) {
 		timer->set_time_left(duration);
 	} else {
@@ -81,7 +85,7 @@ void BTCooldown::_chill() {
 }
 
 void BTCooldown::_on_timeout() {
-	get_blackboard()->set_var(cooldown_state_var, false);
+	get_blackboard()->set_bool_by_handle(cooldown_state_handle, false);
 	timer.unref();
 }
 
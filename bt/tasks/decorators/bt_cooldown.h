@@ -32,6 +32,7 @@ private:
 	bool start_cooled = false;
 	bool trigger_on_failure = false;
 	StringName cooldown_state_var = "";
+	int cooldown_state_handle = -1;
 
 	Ref<SceneTreeTimer> timer = nullptr;
 
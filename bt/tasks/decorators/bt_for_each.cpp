@@ -53,7 +53,7 @@ BT::Status BTForEach::_tick(double p_delta) {
 	Variant elem = arr[current_idx];
 	get_blackboard()->set_var(save_var, elem);
 
-	Status status = get_child(0)->execute(p_delta);
+	Status status = get_child_ptr(0)->execute(p_delta);
 	if (status == RUNNING) {
 		return RUNNING;
 	} else if (status == FAILURE) {
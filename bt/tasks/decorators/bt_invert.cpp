@@ -13,7 +13,7 @@
 
 BT::Status BTInvert::_tick(double p_delta) {
 	ERR_FAIL_COND_V_MSG(get_child_count() == 0, FAILURE, "BT decorator has no child.");
-	Status status = get_child(0)->execute(p_delta);
+	Status status = get_child_ptr(0)->execute(p_delta);
 	if (status == SUCCESS) {
 		status = FAILURE;
 	} else if (status == FAILURE) {
@@ -32,6 +32,9 @@ protected:
 	virtual String _generate_name() override;
 	virtual void _enter() override;
 	virtual Status _tick(double p_delta) override;
+	virtual bool _is_pass_through() const override { return true; }
+	virtual bool _is_thread_safe() const override { return true; }
+	virtual bool _is_reusable() const override { return true; }
 
 public:
 	void set_forever(bool p_forever);
@@ -35,6 +35,8 @@ protected:
 
 	virtual String _generate_name() override;
 	virtual Status _tick(double p_delta) override;
+	virtual bool _is_pass_through() const override { return true; }
+	virtual bool _is_thread_safe() const override { return true; }
 
 public:
 	void set_run_limit(int p_value);
@@ -57,16 +57,40 @@ String BTSubtree::_generate_name() {
 void BTSubtree::initialize(Node *p_agent, const Ref<Blackboard> &p_blackboard, Node *p_scene_root) {
 	ERR_FAIL_COND_MSG(!subtree.is_valid(), "Subtree is not assigned.");
 	ERR_FAIL_COND_MSG(!subtree->get_root_task().is_valid(), "Subtree root task is not valid.");
+	if (get_agent() != nullptr) {
+		// * Re-initializing a recycled instance (see BTInstancePool): the subtree is already there.
+		BTNewScope::initialize(p_agent, p_blackboard, p_scene_root);
+		return;
+	}
 	ERR_FAIL_COND_MSG(get_child_count() != 0, "Subtree task shouldn't have children during initialization.");
-
-	add_child(subtree->get_root_task()->clone());
-
+	if (lazy) {
+		// * The subtree is cloned on the first _enter().
+		BTNewScope::initialize(p_agent, p_blackboard, p_scene_root);
+		return;
+	}
+	Ref<BTTask> prototype = subtree->get_runtime_prototype();
+	ERR_FAIL_COND_MSG(prototype.is_null(), "Subtree root task is disabled.");
+	add_child(prototype->clone());
 	BTNewScope::initialize(p_agent, p_blackboard, p_scene_root);
 }
 
+void BTSubtree::_enter() {
+	if (!lazy || get_child_count() > 0) {
+		return;
+	}
+	ERR_FAIL_COND_MSG(!subtree.is_valid(), "Subtree is not assigned.");
+	Ref<BTTask> prototype = subtree->get_runtime_prototype();
+	ERR_FAIL_COND_MSG(prototype.is_null(), "Subtree root task is disabled.");
+	// * The instance recompiles its layout on the next update; until then, the subtree runs
+	// through the regular hierarchy.
+	Ref<BTTask> child = prototype->clone();
+	_add_deferred_child(child);
+	child->initialize(get_agent(), get_blackboard(), get_scene_root());
+}
+
 BT::Status BTSubtree::_tick(double p_delta) {
 	ERR_FAIL_COND_V_MSG(get_child_count() == 0, FAILURE, "BT decorator doesn't have a child.");
-	return get_child(0)->execute(p_delta);
+	return get_child_ptr(0)->execute(p_delta);
 }
 
 PackedStringArray BTSubtree::get_configuration_warnings() {
@@ -80,8 +104,11 @@ PackedStringArray BTSubtree::get_configuration_warnings() {
 void BTSubtree::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_subtree", "behavior_tree"), &BTSubtree::set_subtree);
 	ClassDB::bind_method(D_METHOD("get_subtree"), &BTSubtree::get_subtree);
+	ClassDB::bind_method(D_METHOD("set_lazy", "lazy"), &BTSubtree::set_lazy);
+	ClassDB::bind_method(D_METHOD("is_lazy"), &BTSubtree::is_lazy);
 
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "subtree", PROPERTY_HINT_RESOURCE_TYPE, "BehaviorTree"), "set_subtree", "get_subtree");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "lazy"), "set_lazy", "is_lazy");
 }
 
 BTSubtree::~BTSubtree() {
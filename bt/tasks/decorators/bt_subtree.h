@@ -22,6 +22,7 @@ class BTSubtree : public BTNewScope {
 
 private:
 	Ref<BehaviorTree> subtree;
+	bool lazy = false;
 
 protected:
 	static void _bind_methods();
@@ -29,12 +30,20 @@ protected:
 	virtual void _update_blackboard_plan() override;
 
 	virtual String _generate_name() override;
+	virtual void _enter() override;
 	virtual Status _tick(double p_delta) override;
+	virtual bool _is_thread_safe() const override { return !lazy; }
 
 public:
 	void set_subtree(const Ref<BehaviorTree> &p_value);
 	Ref<BehaviorTree> get_subtree() const { return subtree; }
 
+	void set_lazy(bool p_lazy) {
+		lazy = p_lazy;
+		emit_changed();
+	}
+	bool is_lazy() const { return lazy; }
+
 	virtual void initialize(Node *p_agent, const Ref<Blackboard> &p_blackboard, Node *p_scene_root) override;
 	virtual PackedStringArray get_configuration_warnings() override;
 
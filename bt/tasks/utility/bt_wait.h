@@ -26,6 +26,8 @@ protected:
 
 	virtual String _generate_name() override;
 	virtual Status _tick(double p_delta) override;
+	virtual bool _is_thread_safe() const override { return true; }
+	virtual bool _is_reusable() const override { return true; }
 
 public:
 	void set_duration(double p_value) {
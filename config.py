@@ -84,6 +84,7 @@ def get_doc_classes():
         "BTFail",
         "BTForEach",
         "BTInstance",
+        "BTInstancePool",
         "BTInvert",
         "BTNewScope",
         "BTParallel",
@@ -128,7 +128,8 @@ void LimboDebugger::_track_tree(uint64_t p_instance_id) {
 
 	BTInstance *inst = Object::cast_to<BTInstance>(OBJECT_DB_GET_INSTANCE(p_instance_id));
 	ERR_FAIL_NULL(inst);
-	inst->connect(LW_NAME(updated), callable_mp(this, &LimboDebugger::_on_bt_instance_updated).bind(p_instance_id));
+	// * Not using the "updated" signal, as it may be emitted only on status changes.
+	inst->set_debugger_callback(&LimboDebugger::_on_bt_instance_updated);
 }
 
 void LimboDebugger::_untrack_tree() {
@@ -138,7 +139,7 @@ void LimboDebugger::_untrack_tree() {
 
 	BTInstance *inst = Object::cast_to<BTInstance>(OBJECT_DB_GET_INSTANCE(tracked_instance_id));
 	if (inst) {
-		inst->disconnect(LW_NAME(updated), callable_mp(this, &LimboDebugger::_on_bt_instance_updated));
+		inst->set_debugger_callback(nullptr);
 	}
 	tracked_instance_id = 0;
 }
@@ -158,13 +159,9 @@ void LimboDebugger::_send_active_bt_players() {
 	EngineDebugger::get_singleton()->send_message("limboai:active_bt_players", arr);
 }
 
-void LimboDebugger::_on_bt_instance_updated(int _status, uint64_t p_instance_id) {
-	if (p_instance_id != tracked_instance_id) {
-		return;
-	}
-	BTInstance *inst = Object::cast_to<BTInstance>(OBJECT_DB_GET_INSTANCE(p_instance_id));
-	ERR_FAIL_NULL(inst);
-	Array arr = BehaviorTreeData::serialize(inst);
+void LimboDebugger::_on_bt_instance_updated(BTInstance *p_instance, BT::Status p_status, void *p_userdata) {
+	// * Only set on the tracked instance.
+	Array arr = BehaviorTreeData::serialize(p_instance);
 	EngineDebugger::get_singleton()->send_message("limboai:bt_update", arr);
 }
 
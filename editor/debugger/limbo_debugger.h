@@ -12,6 +12,8 @@
 #ifndef LIMBO_DEBUGGER_H
 #define LIMBO_DEBUGGER_H
 
+#include "../../bt/bt_instance.h"
+
 #ifdef LIMBOAI_MODULE
 #include "core/object/class_db.h"
 #include "core/object/object.h"
@@ -52,7 +54,7 @@ private:
 	void _untrack_tree();
 	void _send_active_bt_players();
 
-	void _on_bt_instance_updated(int status, uint64_t p_instance_id);
+	static void _on_bt_instance_updated(BTInstance *p_instance, BT::Status p_status, void *p_userdata);
 
 public:
 	static Error parse_message(void *p_user, const String &p_msg, const Array &p_args, bool &r_captured);
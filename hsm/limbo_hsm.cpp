@@ -11,6 +11,8 @@
 
 #include "limbo_hsm.h"
 
+#include "../util/limbo_tick_server.h"
+
 VARIANT_ENUM_CAST(LimboHSM::UpdateMode);
 
 void LimboHSM::set_active(bool p_active) {
@@ -22,19 +24,25 @@ void LimboHSM::set_active(bool p_active) {
 	}
 
 	active = p_active;
-	switch (update_mode) {
-		case UpdateMode::IDLE: {
-			set_process(p_active);
-			set_physics_process(false);
-		} break;
-		case UpdateMode::PHYSICS: {
-			set_process(false);
-			set_physics_process(p_active);
-		} break;
-		case UpdateMode::MANUAL: {
-			set_process(false);
-			set_physics_process(false);
-		} break;
+	if (LimboTickServer::is_enabled()) {
+		set_process(false);
+		set_physics_process(false);
+		_set_tick_server_process(p_active && update_mode != UpdateMode::MANUAL);
+	} else {
+		switch (update_mode) {
+			case UpdateMode::IDLE: {
+				set_process(p_active);
+				set_physics_process(false);
+			} break;
+			case UpdateMode::PHYSICS: {
+				set_process(false);
+				set_physics_process(p_active);
+			} break;
+			case UpdateMode::MANUAL: {
+				set_process(false);
+				set_physics_process(false);
+			} break;
+		}
 	}
 	set_process_input(p_active);
 	set_process_unhandled_input(p_active);
@@ -46,6 +54,34 @@ void LimboHSM::set_active(bool p_active) {
 	}
 }
 
+void LimboHSM::_set_tick_server_process(bool p_enable) {
+	tick_server_process = p_enable;
+	_update_tick_server_registration();
+}
+
+void LimboHSM::_update_tick_server_registration() {
+	LimboTickServer *server = LimboTickServer::get_singleton();
+	ERR_FAIL_NULL(server);
+	// * Like regular processing, ticks are only received while inside the scene tree.
+	if (tick_server_process && is_inside_tree()) {
+		LimboTickServer::TickGroup group = update_mode == UpdateMode::IDLE ? LimboTickServer::TICK_IDLE : LimboTickServer::TICK_PHYSICS;
+		server->register_node(this, group, &LimboHSM::_tick_server_callback);
+	} else {
+		server->unregister_node(this);
+	}
+}
+
+void LimboHSM::_tick_server_callback(Node *p_node, double p_delta) {
+	static_cast<LimboHSM *>(p_node)->_auto_update(p_delta);
+}
+
+void LimboHSM::_auto_update(double p_delta) {
+	if (lod.is_enabled() && !lod.advance(p_delta, this, agent, p_delta)) {
+		return;
+	}
+	_update(p_delta);
+}
+
 void LimboHSM::change_active_state(LimboState *p_state) {
 	ERR_FAIL_NULL(p_state);
 	ERR_FAIL_COND_MSG(!is_active(), "LimboHSM: Unable to change active state when HSM is not active.");
@@ -262,8 +298,8 @@ void LimboHSM::_initialize(Node *p_agent, const Ref<Blackboard> &p_blackboard) {
 }
 
 void LimboHSM::_validate_property(PropertyInfo &p_property) const {
-	if (p_property.name == LW_NAME(update_mode) && !is_root()) {
-		// Hide update_mode for non-root HSMs.
+	if ((p_property.name == LW_NAME(update_mode) || String(p_property.name).begins_with("lod_")) && !is_root()) {
+		// Hide update_mode and LOD properties for non-root HSMs.
 		p_property.usage = PROPERTY_USAGE_NONE;
 	}
 }
@@ -276,6 +312,11 @@ void LimboHSM::_exit_if_not_inside_tree() {
 
 void LimboHSM::_notification(int p_what) {
 	switch (p_what) {
+		case NOTIFICATION_ENTER_TREE: {
+			if (tick_server_process) {
+				_update_tick_server_registration();
+			}
+		} break;
 		case NOTIFICATION_POST_ENTER_TREE: {
 			if (was_active && is_root()) {
 				// Re-activate the root HSM if it was previously active.
@@ -284,6 +325,9 @@ void LimboHSM::_notification(int p_what) {
 			}
 		} break;
 		case NOTIFICATION_EXIT_TREE: {
+			if (tick_server_process) {
+				LimboTickServer::get_singleton()->unregister_node(this);
+			}
 			if (is_root()) {
 				// Exit the state machine if the root HSM is no longer in the scene tree (except when being reparented).
 				// This ensures that resources and signal connections are released if active.
@@ -312,10 +356,10 @@ void LimboHSM::_notification(int p_what) {
 			}
 		} break;
 		case NOTIFICATION_PROCESS: {
-			_update(get_process_delta_time());
+			_auto_update(get_process_delta_time());
 		} break;
 		case NOTIFICATION_PHYSICS_PROCESS: {
-			_update(get_physics_process_delta_time());
+			_auto_update(get_physics_process_delta_time());
 		} break;
 	}
 }
@@ -323,6 +367,14 @@ void LimboHSM::_notification(int p_what) {
 void LimboHSM::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_update_mode", "mode"), &LimboHSM::set_update_mode);
 	ClassDB::bind_method(D_METHOD("get_update_mode"), &LimboHSM::get_update_mode);
+	ClassDB::bind_method(D_METHOD("set_lod_level", "level"), &LimboHSM::set_lod_level);
+	ClassDB::bind_method(D_METHOD("get_lod_level"), &LimboHSM::get_lod_level);
+	ClassDB::bind_method(D_METHOD("set_lod_level_callback", "callback"), &LimboHSM::set_lod_level_callback);
+	ClassDB::bind_method(D_METHOD("get_lod_level_callback"), &LimboHSM::get_lod_level_callback);
+	ClassDB::bind_method(D_METHOD("set_lod_distances", "distances"), &LimboHSM::set_lod_distances);
+	ClassDB::bind_method(D_METHOD("get_lod_distances"), &LimboHSM::get_lod_distances);
+	ClassDB::bind_method(D_METHOD("set_lod_reference_node", "path"), &LimboHSM::set_lod_reference_node);
+	ClassDB::bind_method(D_METHOD("get_lod_reference_node"), &LimboHSM::get_lod_reference_node);
 
 	ClassDB::bind_method(D_METHOD("set_initial_state", "state"), &LimboHSM::set_initial_state);
 	ClassDB::bind_method(D_METHOD("get_initial_state"), &LimboHSM::get_initial_state);
@@ -346,6 +398,10 @@ void LimboHSM::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "update_mode", PROPERTY_HINT_ENUM, "Idle, Physics, Manual"), "set_update_mode", "get_update_mode");
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "ANYSTATE", PROPERTY_HINT_RESOURCE_TYPE, "LimboState", 0), "", "anystate");
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "initial_state", PROPERTY_HINT_RESOURCE_TYPE, "LimboState", 0), "set_initial_state", "get_initial_state");
+	ADD_GROUP("LOD", "lod_");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "lod_level", PROPERTY_HINT_RANGE, "0,8,1,or_greater"), "set_lod_level", "get_lod_level");
+	ADD_PROPERTY(PropertyInfo(Variant::PACKED_FLOAT32_ARRAY, "lod_distances"), "set_lod_distances", "get_lod_distances");
+	ADD_PROPERTY(PropertyInfo(Variant::NODE_PATH, "lod_reference_node"), "set_lod_reference_node", "get_lod_reference_node");
 
 	ADD_SIGNAL(MethodInfo("active_state_changed",
 			PropertyInfo(Variant::OBJECT, "current", PROPERTY_HINT_RESOURCE_TYPE, "LimboState"),
@@ -14,6 +14,8 @@
 
 #include "limbo_state.h"
 
+#include "../util/limbo_tick_lod.h"
+
 #define TransitionKey Pair<uint64_t, StringName>
 
 class LimboHSM : public LimboState {
@@ -59,12 +61,19 @@ private:
 	LimboState *next_active;
 	bool updating = false;
 	bool was_active = false;
+	bool tick_server_process = false;
+	LimboTickLOD lod;
 
 	HashMap<TransitionKey, Transition, TransitionKeyHasher> transitions;
 
 	void _get_transition(LimboState *p_from_state, const StringName &p_event, Transition &r_transition) const;
 	void _exit_if_not_inside_tree();
 
+	void _set_tick_server_process(bool p_enable);
+	void _update_tick_server_registration();
+	static void _tick_server_callback(Node *p_node, double p_delta);
+	void _auto_update(double p_delta);
+
 protected:
 	static void _bind_methods();
 
@@ -82,6 +91,18 @@ public:
 	void set_update_mode(UpdateMode p_mode) { update_mode = p_mode; }
 	UpdateMode get_update_mode() const { return update_mode; }
 
+	void set_lod_level(int p_level) { lod.set_level(p_level); }
+	int get_lod_level() const { return lod.get_level(); }
+
+	void set_lod_level_callback(const Callable &p_callback) { lod.set_level_callback(p_callback); }
+	Callable get_lod_level_callback() const { return lod.get_level_callback(); }
+
+	void set_lod_distances(const PackedFloat32Array &p_distances) { lod.set_distances(p_distances); }
+	PackedFloat32Array get_lod_distances() const { return lod.get_distances(); }
+
+	void set_lod_reference_node(const NodePath &p_path) { lod.set_reference_node(p_path); }
+	NodePath get_lod_reference_node() const { return lod.get_reference_node(); }
+
 	void set_active(bool p_active);
 
 	void change_active_state(LimboState *p_state);
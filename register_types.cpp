@@ -49,6 +49,7 @@
 #include "blackboard/blackboard.h"
 #include "blackboard/blackboard_plan.h"
 #include "bt/behavior_tree.h"
+#include "bt/bt_instance_pool.h"
 #include "bt/bt_player.h"
 #include "bt/bt_state.h"
 #include "bt/tasks/blackboard/bt_check_trigger.h"
@@ -108,6 +109,7 @@
 #include "hsm/limbo_state.h"
 #include "util/limbo_string_names.h"
 #include "util/limbo_task_db.h"
+#include "util/limbo_tick_server.h"
 #include "util/limbo_utility.h"
 
 #ifdef TOOLS_ENABLED
@@ -138,8 +140,11 @@ void initialize_limboai_module(ModuleInitializationLevel p_level) {
 		GDREGISTER_CLASS(BehaviorTreeData);
 #ifdef LIMBOAI_GDEXTENSION
 		GDREGISTER_CLASS(LimboDebugger);
+		GDREGISTER_CLASS(LimboTickServer);
 #endif
 		LimboDebugger::initialize();
+		LimboTickServer::initialize();
+		BTTask::initialize_clone_plans();
 
 		GDREGISTER_CLASS(LimboUtility);
 		GDREGISTER_CLASS(Blackboard);
@@ -152,6 +157,7 @@ void initialize_limboai_module(ModuleInitializationLevel p_level) {
 		GDREGISTER_ABSTRACT_CLASS(BTTask);
 		GDREGISTER_CLASS(BehaviorTree);
 		GDREGISTER_CLASS(BTInstance);
+		GDREGISTER_CLASS(BTInstancePool);
 		GDREGISTER_CLASS(BTPlayer);
 		GDREGISTER_CLASS(BTState);
 
@@ -287,6 +293,8 @@ void initialize_limboai_module(ModuleInitializationLevel p_level) {
 void uninitialize_limboai_module(ModuleInitializationLevel p_level) {
 	if (p_level == MODULE_INITIALIZATION_LEVEL_SCENE) {
 		LimboDebugger::deinitialize();
+		LimboTickServer::deinitialize();
+		BTTask::finalize_clone_plans();
 		LimboStringNames::free();
 		memdelete(_limbo_utility);
 	}
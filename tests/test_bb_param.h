@@ -83,6 +83,10 @@ TEST_CASE("[Modules][LimboAI] BBNode") {
 	other->set_name("Other");
 	dummy->add_child(other);
 
+	// * Resolves node paths in the scene tree, so it's never safe to read on worker threads.
+	CHECK_FALSE(param->is_thread_safe());
+	CHECK(Ref<BBVariant>(memnew(BBVariant))->is_thread_safe());
+
 	SUBCASE("With a valid path") {
 		param->set_value_source(BBParam::SAVED_VALUE);
 		param->set_saved_value(NodePath("./Other"));
@@ -0,0 +1,280 @@
+/**
+ * test_benchmark.h
+ * =============================================================================
+ * Copyright (c) 2023-present Serhii Snitsaruk and the LimboAI contributors.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#ifndef TEST_BENCHMARK_H
+#define TEST_BENCHMARK_H
+
+#include "limbo_test.h"
+
+#include "modules/limboai/blackboard/bb_param/bb_variant.h"
+#include "modules/limboai/blackboard/blackboard.h"
+#include "modules/limboai/bt/behavior_tree.h"
+#include "modules/limboai/bt/bt_instance.h"
+#include "modules/limboai/bt/tasks/blackboard/bt_check_var.h"
+#include "modules/limboai/bt/tasks/bt_task.h"
+#include "modules/limboai/bt/tasks/composites/bt_sequence.h"
+#include "modules/limboai/bt/tasks/decorators/bt_always_succeed.h"
+#include "modules/limboai/bt/tasks/decorators/bt_repeat.h"
+#include "modules/limboai/bt/tasks/utility/bt_fail.h"
+
+#include "core/os/os.h"
+
+// * Benchmarks are skipped by default. Run with: --test --test-case="*[Benchmark]*" --no-skip
+
+namespace TestBenchmark {
+
+// * Repeat (forever) -> Sequence -> N x AlwaysSucceed -> Fail
+// * Every tick enters, ticks and exits all tasks except the root.
+static Ref<BTTask> make_native_tree(int p_num_branches) {
+	Ref<BTRepeat> repeat = memnew(BTRepeat);
+	repeat->set_forever(true);
+	Ref<BTSequence> seq = memnew(BTSequence);
+	repeat->add_child(seq);
+	for (int i = 0; i < p_num_branches; i++) {
+		Ref<BTAlwaysSucceed> dec = memnew(BTAlwaysSucceed);
+		dec->add_child(memnew(BTFail));
+		seq->add_child(dec);
+	}
+	return repeat;
+}
+
+static double measure_ns_per_tick(const Ref<BTTask> &p_root, int p_num_ticks) {
+	p_root->execute(0.01666); // * Warm-up.
+	uint64_t start = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < p_num_ticks; i++) {
+		p_root->execute(0.01666);
+	}
+	uint64_t end = OS::get_singleton()->get_ticks_usec();
+	return double(end - start) * 1000.0 / p_num_ticks;
+}
+
+TEST_CASE("[Modules][LimboAI][Benchmark] BTTask::execute() on an all-native tree" * doctest::skip()) {
+	const int num_branches = 100;
+	const int num_ticks = 10000;
+
+	Node *agent = memnew(Node);
+	Ref<Blackboard> bb = memnew(Blackboard);
+
+	// * Before initialize(), every virtual is assumed to be overridden by a script.
+	Ref<BTTask> uncached = make_native_tree(num_branches);
+	double ns_uncached = measure_ns_per_tick(uncached, num_ticks);
+
+	Ref<BTTask> cached = make_native_tree(num_branches);
+	cached->initialize(agent, bb, agent);
+	double ns_cached = measure_ns_per_tick(cached, num_ticks);
+
+	print_line(vformat("BTTask::execute() on %d native tasks: %.1f ns/tick with script lookups, %.1f ns/tick with cached overrides.",
+			num_branches * 2 + 2, ns_uncached, ns_cached));
+	CHECK(cached->get_status() == BTTask::RUNNING);
+
+	memdelete(agent);
+}
+
+TEST_CASE("[Modules][LimboAI][Benchmark] BTInstance::update() on a 1000-task tree" * doctest::skip()) {
+	const int num_ticks = 10000;
+
+	// * 2 + 499 x 2 = 1000 tasks, all of which are visited on every tick.
+	// * Tracks the overall tick cost; see the BTTask::Data layout benchmark for a before/after comparison.
+	Ref<BehaviorTree> bt = memnew(BehaviorTree);
+	bt->set_root_task(make_native_tree(499));
+
+	Node *agent = memnew(Node);
+	Ref<Blackboard> bb = memnew(Blackboard);
+	Ref<BTInstance> inst = bt->instantiate(agent, bb, agent);
+	REQUIRE(inst.is_valid());
+
+	inst->update(0.01666); // * Warm-up.
+	uint64_t start = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < num_ticks; i++) {
+		inst->update(0.01666);
+	}
+	uint64_t end = OS::get_singleton()->get_ticks_usec();
+	double ns_per_tick = double(end - start) * 1000.0 / num_ticks;
+
+	print_line(vformat("BTInstance::update() on 1000 native tasks: %.1f ns/tick, %.2f ns/task (sizeof(BTTask) = %d bytes).",
+			ns_per_tick, ns_per_tick / 1000.0, (int)sizeof(BTTask)));
+	CHECK(inst->get_last_status() == BTTask::RUNNING);
+
+	memdelete(agent);
+}
+
+// * Field order of BTTask::Data before the hot/cold split.
+struct DataBeforeSplit {
+	int index = -1;
+	int compiled_index = -1;
+	void *compiled_tree = nullptr;
+	String custom_name;
+	Node *agent = nullptr;
+	Node *scene_root = nullptr;
+	Ref<Blackboard> blackboard;
+	void *parent = nullptr;
+	Vector<Ref<BTTask>> children;
+	BT::Status status = BT::FRESH;
+	double elapsed = 0.0;
+	bool display_collapsed = false;
+	bool enabled = true;
+	uint8_t script_overrides = 0;
+	bool pass_through = false;
+	bool resume_latched = false;
+	bool suspended = false;
+	ObjectID behavior_tree_id;
+};
+
+// * Field order of BTTask::Data after the split: hot, warm, then a pointer to the cold fields.
+struct DataAfterSplit {
+	BT::Status status = BT::FRESH;
+	double elapsed = 0.0;
+	Vector<Ref<BTTask>> children;
+	void *compiled_tree = nullptr;
+	int compiled_index = -1;
+	bool enabled = true;
+	uint8_t script_overrides = 0;
+	bool pass_through = false;
+	bool resume_latched = false;
+	bool suspended = false;
+	void *parent = nullptr;
+	int index = -1;
+	bool prototype = false;
+	Node *agent = nullptr;
+	Node *scene_root = nullptr;
+	Ref<Blackboard> blackboard;
+	void *cold = nullptr;
+};
+
+// Reads and writes the fields that execute() touches, over p_num_tasks heap objects
+// the size of a task, and returns ns per task visit.
+template <typename T>
+static double measure_hot_field_walk(int p_num_tasks, int p_num_passes) {
+	struct FakeTask {
+		uint8_t resource[sizeof(Resource)];
+		T data;
+	};
+	LocalVector<FakeTask *> tasks;
+	tasks.resize(p_num_tasks);
+	for (int i = 0; i < p_num_tasks; i++) {
+		tasks[i] = memnew(FakeTask);
+	}
+
+	int64_t checksum = 0;
+	uint64_t start = OS::get_singleton()->get_ticks_usec();
+	for (int pass = 0; pass < p_num_passes; pass++) {
+		for (FakeTask *task : tasks) {
+			T &data = task->data;
+			if (data.enabled && !data.resume_latched && data.compiled_index < 0) {
+				data.status = BT::RUNNING;
+				data.elapsed += 0.01666;
+				checksum += data.children.size() + data.script_overrides;
+			}
+		}
+	}
+	uint64_t end = OS::get_singleton()->get_ticks_usec();
+
+	for (FakeTask *task : tasks) {
+		memdelete(task);
+	}
+	CHECK(checksum == 0);
+	return double(end - start) * 1000.0 / (double(p_num_tasks) * p_num_passes);
+}
+
+TEST_CASE("[Modules][LimboAI][Benchmark] BTTask::Data layout before and after the hot/cold split" * doctest::skip()) {
+	// * 64 trees of 1000 tasks, which exceeds the L2 cache, so that each visit may miss.
+	const int num_tasks = 64 * 1000;
+	const int num_passes = 200;
+
+	measure_hot_field_walk<DataBeforeSplit>(num_tasks, 1); // * Warm-up.
+	const double before = measure_hot_field_walk<DataBeforeSplit>(num_tasks, num_passes);
+	const double after = measure_hot_field_walk<DataAfterSplit>(num_tasks, num_passes);
+
+	print_line(vformat("Hot BTTask::Data fields over %d tasks: %.2f ns/task before the split (%d bytes), %.2f ns/task after (%d bytes).",
+			num_tasks, before, (int)sizeof(DataBeforeSplit), after, (int)sizeof(DataAfterSplit)));
+}
+
+TEST_CASE("[Modules][LimboAI][Benchmark] BehaviorTree::instantiate() of a 500-task tree" * doctest::skip()) {
+	const int num_instances = 1000;
+
+	// * Repeat -> Sequence -> 249 x (AlwaysSucceed -> CheckVar), each CheckVar holding a BBParam.
+	Ref<BTRepeat> repeat = memnew(BTRepeat);
+	Ref<BTSequence> seq = memnew(BTSequence);
+	repeat->add_child(seq);
+	for (int i = 0; i < 249; i++) {
+		Ref<BTAlwaysSucceed> dec = memnew(BTAlwaysSucceed);
+		Ref<BTCheckVar> check = memnew(BTCheckVar);
+		check->set_variable("var");
+		check->set_value(memnew(BBVariant));
+		dec->add_child(check);
+		seq->add_child(dec);
+	}
+	Ref<BehaviorTree> bt = memnew(BehaviorTree);
+	bt->set_root_task(repeat);
+
+	Node *agent = memnew(Node);
+	Ref<Blackboard> bb = memnew(Blackboard);
+	bb->set_var("var", 0);
+
+	Ref<BTInstance> warm_up = bt->instantiate(agent, bb, agent);
+	REQUIRE(warm_up.is_valid());
+
+	uint64_t start = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < num_instances; i++) {
+		Ref<BTInstance> inst = bt->instantiate(agent, bb, agent);
+	}
+	uint64_t end = OS::get_singleton()->get_ticks_usec();
+
+	print_line(vformat("BehaviorTree::instantiate() of 500 tasks: %.1f us/instance.", double(end - start) / num_instances));
+
+	Ref<BTCheckVar> cloned = warm_up->get_root_task()->get_child(0)->get_child(0)->get_child(0);
+	REQUIRE(cloned.is_valid());
+	CHECK(cloned->get_value().is_valid());
+
+	memdelete(agent);
+}
+
+TEST_CASE("[Modules][LimboAI][Benchmark] Blackboard::get_var() through 6 scopes" * doctest::skip()) {
+	const int num_reads = 1000000;
+
+	Ref<Blackboard> top = memnew(Blackboard);
+	top->set_var("speed", 1.0);
+	Ref<Blackboard> bb = top;
+	for (int i = 0; i < 5; i++) {
+		Ref<Blackboard> scope = memnew(Blackboard);
+		scope->set_var(vformat("local_%d", i), i);
+		scope->set_parent(bb);
+		bb = scope;
+	}
+
+	// * Before memoization: each read by name walks the chain, one lookup per scope.
+	double sum = 0.0;
+	uint64_t start = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < num_reads; i++) {
+		sum += double(bb->get_var("speed"));
+	}
+	uint64_t walked = OS::get_singleton()->get_ticks_usec();
+
+	// * After memoization: the handle's slot is reused by reads by name as well.
+	const int handle = bb->get_var_handle("speed");
+	uint64_t memo_start = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < num_reads; i++) {
+		sum += double(bb->get_var("speed"));
+	}
+	uint64_t memoized = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < num_reads; i++) {
+		sum += double(bb->get_var_by_handle(handle));
+	}
+	uint64_t end = OS::get_singleton()->get_ticks_usec();
+
+	print_line(vformat("Blackboard::get_var() through 6 scopes: %.1f ns/read by name before memoization, %.1f ns/read by name after, %.1f ns/read by handle.",
+			double(walked - start) * 1000.0 / num_reads, double(memoized - memo_start) * 1000.0 / num_reads, double(end - memoized) * 1000.0 / num_reads));
+	CHECK(sum == 3.0 * num_reads);
+}
+
+} //namespace TestBenchmark
+
+#endif // TEST_BENCHMARK_H
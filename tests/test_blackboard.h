@@ -5,6 +5,7 @@
 #include "limbo_test.h"
 
 #include "modules/limboai/blackboard/blackboard.h"
+#include "scene/main/node.h"
 
 namespace TestBlackboard {
 
@@ -25,6 +26,10 @@ public:
 	}
 };
 
+static void count_changes(void *p_userdata, const StringName &p_name, const Variant &p_value) {
+	*(int *)p_userdata += 1;
+}
+
 TEST_CASE("[Modules][LimboAI] Test Blackboard") {
 	Ref<Blackboard> blackboard = memnew(Blackboard);
 
@@ -160,6 +165,37 @@ TEST_CASE("[Modules][LimboAI] Test Blackboard") {
 		CHECK_EQ(blackboard->get_var("a", not_found), Variant(7));
 	}
 
+	SUBCASE("Test binding to a native property") {
+		Node *node = memnew(Node);
+		blackboard->bind_var_to_property("a", node, "process_priority");
+
+		node->set_process_priority(5);
+		CHECK_EQ(blackboard->get_var("a", not_found), Variant(5));
+		blackboard->set_var("a", Variant(6));
+		CHECK_EQ(node->get_process_priority(), 6);
+
+		// * Accessors are shared by duplicates.
+		BBVariable var;
+		var.bind(node, "process_priority");
+		BBVariable dup = var.duplicate();
+		dup.set_value(7);
+		CHECK_EQ(node->get_process_priority(), 7);
+		CHECK_EQ(var.get_value(), Variant(7));
+
+		blackboard->unbind_var("a");
+		memdelete(node);
+
+		// * The cached object is cleared when it's freed, including in duplicates.
+		Node *freed = memnew(Node);
+		blackboard->bind_var_to_property("b", freed, "process_priority", true);
+		blackboard->set_var("b", 8);
+		memdelete(freed);
+		ERR_PRINT_OFF;
+		CHECK_EQ(blackboard->get_var("b", not_found), Variant(8));
+		CHECK_EQ(dup.get_value(), Variant(7));
+		ERR_PRINT_ON;
+	}
+
 	SUBCASE("Test linking") {
 		Ref<Blackboard> target_blackboard = memnew(Blackboard);
 
@@ -179,6 +215,204 @@ TEST_CASE("[Modules][LimboAI] Test Blackboard") {
 		CHECK_EQ(blackboard->get_var("a", not_found), Variant(333));
 		CHECK_EQ(target_blackboard->get_var("aa", not_found), Variant(333));
 	}
+	SUBCASE("Test scope resolution after changes in the scope chain") {
+		Ref<Blackboard> parent_scope = memnew(Blackboard);
+		Ref<Blackboard> grand_parent_scope = memnew(Blackboard);
+		parent_scope->set_parent(grand_parent_scope);
+		blackboard->set_parent(parent_scope);
+
+		grand_parent_scope->set_var("e", 1);
+		CHECK(blackboard->has_var("e"));
+		CHECK_EQ(blackboard->get_var("e", not_found), Variant(1));
+
+		parent_scope->set_var("e", 2); // * Shadows the grand parent variable.
+		CHECK_EQ(blackboard->get_var("e", not_found), Variant(2));
+
+		parent_scope->erase_var("e");
+		CHECK_EQ(blackboard->get_var("e", not_found), Variant(1));
+
+		grand_parent_scope->clear();
+		CHECK_FALSE(blackboard->has_var("e"));
+		CHECK_EQ(blackboard->get_var("e", not_found, false), not_found);
+
+		Ref<Blackboard> other_scope = memnew(Blackboard);
+		other_scope->set_var("e", 3);
+		blackboard->set_parent(other_scope);
+		CHECK_EQ(blackboard->get_var("e", not_found), Variant(3));
+	}
+	SUBCASE("Test typed access by handle") {
+		blackboard->set_var("speed", 2.5);
+		blackboard->set_var("alert", true);
+		blackboard->set_var("position", Vector3(1, 2, 3));
+		const int handle_a = blackboard->get_var_handle("a");
+		const int handle_b = blackboard->get_var_handle("b");
+		const int handle_c = blackboard->get_var_handle("c");
+		const int handle_speed = blackboard->get_var_handle("speed");
+		const int handle_alert = blackboard->get_var_handle("alert");
+		const int handle_position = blackboard->get_var_handle("position");
+
+		CHECK_EQ(blackboard->get_int_by_handle(handle_a), 1);
+		CHECK_EQ(blackboard->get_vector2_by_handle(handle_b), Vector2(2, 2));
+		CHECK_EQ(blackboard->get_float_by_handle(handle_speed), 2.5);
+		CHECK(blackboard->get_bool_by_handle(handle_alert));
+		CHECK_EQ(blackboard->get_vector3_by_handle(handle_position), Vector3(1, 2, 3));
+
+		// * Convertible types are converted.
+		CHECK_EQ(blackboard->get_float_by_handle(handle_a), 1.0);
+		CHECK_EQ(blackboard->get_int_by_handle(handle_speed), 2);
+
+		ERR_PRINT_OFF;
+		CHECK_EQ(blackboard->get_vector3_by_handle(handle_c, Vector3(9, 9, 9)), Vector3(9, 9, 9));
+		CHECK_EQ(blackboard->get_float_by_handle(blackboard->get_var_handle("missing"), 7.0), 7.0);
+		ERR_PRINT_ON;
+
+		blackboard->set_float_by_handle(handle_speed, 4.0);
+		blackboard->set_vector3_by_handle(handle_position, Vector3(4, 5, 6));
+		CHECK_EQ(blackboard->get_var("speed", not_found), Variant(4.0));
+		CHECK_EQ(blackboard->get_var("position", not_found), Variant(Vector3(4, 5, 6)));
+	}
+	SUBCASE("Test versions") {
+		const uint64_t bb_version = blackboard->get_version();
+		const uint64_t a_version = blackboard->get_var_version("a");
+		CHECK(a_version > 0);
+		CHECK_EQ(blackboard->get_var_version("missing"), 0);
+
+		blackboard->set_var("a", 2);
+		CHECK_EQ(blackboard->get_var_version("a"), a_version + 1);
+		CHECK_EQ(blackboard->get_var_version_by_handle(blackboard->get_var_handle("a")), a_version + 1);
+		CHECK(blackboard->get_version() > bb_version);
+
+		// * Writes through a link are counted for the shared variable.
+		Ref<Blackboard> target_blackboard = memnew(Blackboard);
+		target_blackboard->set_var("aa", 111);
+		blackboard->link_var("a", target_blackboard, "aa");
+		const uint64_t linked_version = blackboard->get_var_version("a");
+		target_blackboard->set_var("aa", 222);
+		CHECK_EQ(blackboard->get_var_version("a"), linked_version + 1);
+	}
+	SUBCASE("Test observers") {
+		int num_changes = 0;
+		const uint64_t id = blackboard->observe_var("a", count_changes, &num_changes);
+		CHECK(id != 0);
+		blackboard->set_var("a", 2);
+		blackboard->set_var("b", Vector2());
+		CHECK_EQ(num_changes, 1);
+
+		Ref<CallbackCounter> counter = memnew(CallbackCounter);
+		TypedArray<StringName> names;
+		names.push_back("b");
+		names.push_back("c");
+		const uint64_t callable_id = blackboard->observe_vars_callable(names, callable_mp(counter.ptr(), &CallbackCounter::callback).unbind(2));
+		CHECK(callable_id != 0);
+		blackboard->set_var("b", Vector2(1, 1));
+		blackboard->set_var_by_handle(blackboard->get_var_handle("c"), String("4"));
+		CHECK_EQ(counter->num_callbacks, 2);
+
+		// * Writes through a scope linked to the observed variable.
+		Ref<Blackboard> child_scope = memnew(Blackboard);
+		child_scope->set_parent(blackboard);
+		child_scope->link_var("a_alias", blackboard, "a", true);
+		child_scope->set_var("a_alias", 3);
+		CHECK_EQ(num_changes, 2);
+
+		blackboard->remove_observer(id);
+		blackboard->remove_observer(callable_id);
+		blackboard->set_var("a", 4);
+		blackboard->set_var("b", Vector2());
+		CHECK_EQ(num_changes, 2);
+		CHECK_EQ(counter->num_callbacks, 2);
+
+		ERR_PRINT_OFF;
+		CHECK_EQ(blackboard->observe_var("missing", count_changes, &num_changes), 0);
+		ERR_PRINT_ON;
+	}
+	SUBCASE("Test handles") {
+		const int handle_a = blackboard->get_var_handle("a");
+		CHECK(handle_a >= 0);
+		CHECK_EQ(blackboard->get_var_handle("a"), handle_a);
+		CHECK_EQ(blackboard->get_var_handle(""), -1);
+		CHECK(blackboard->has_var_by_handle(handle_a));
+		CHECK_EQ(blackboard->get_var_by_handle(handle_a, not_found), Variant(1));
+
+		blackboard->set_var_by_handle(handle_a, 11);
+		CHECK_EQ(blackboard->get_var("a", not_found), Variant(11));
+		blackboard->set_var("a", 12);
+		CHECK_EQ(blackboard->get_var_by_handle(handle_a, not_found), Variant(12));
+
+		// * Handle of a variable that doesn't exist yet.
+		const int handle_d = blackboard->get_var_handle("d");
+		CHECK_FALSE(blackboard->has_var_by_handle(handle_d));
+		CHECK_EQ(blackboard->get_var_by_handle(handle_d, not_found, false), not_found);
+
+		// * Resolved in the parent scope; writes go to the current scope, as with set_var().
+		Ref<Blackboard> parent_scope = memnew(Blackboard);
+		parent_scope->set_var("d", 123);
+		blackboard->set_parent(parent_scope);
+		CHECK(blackboard->has_var_by_handle(handle_d));
+		CHECK_EQ(blackboard->get_var_by_handle(handle_d, not_found), Variant(123));
+		blackboard->set_var_by_handle(handle_d, 456);
+		CHECK_EQ(blackboard->get_var_by_handle(handle_d, not_found), Variant(456));
+		CHECK_EQ(parent_scope->get_var("d", not_found), Variant(123));
+
+		blackboard->erase_var("d");
+		CHECK_EQ(blackboard->get_var_by_handle(handle_d, not_found), Variant(123));
+		parent_scope->erase_var("d");
+		CHECK_FALSE(blackboard->has_var_by_handle(handle_d));
+
+		// * Follows a variable replaced by linking.
+		Ref<Blackboard> target_blackboard = memnew(Blackboard);
+		target_blackboard->set_var("aa", 111);
+		blackboard->link_var("a", target_blackboard, "aa");
+		CHECK_EQ(blackboard->get_var_by_handle(handle_a, not_found), Variant(111));
+		blackboard->set_var_by_handle(handle_a, 222);
+		CHECK_EQ(target_blackboard->get_var("aa", not_found), Variant(222));
+	}
+	SUBCASE("Test name-based reads don't create handles") {
+		Ref<Blackboard> parent_scope = memnew(Blackboard);
+		parent_scope->set_var("p", 1);
+		blackboard->set_parent(parent_scope);
+
+		const int first_handle = blackboard->get_var_handle("first");
+		for (int i = 0; i < 100; i++) {
+			const String name = "missing_" + itos(i);
+			CHECK_FALSE(blackboard->has_var(name));
+			CHECK_EQ(blackboard->get_var(name, not_found, false), not_found);
+		}
+		CHECK_EQ(blackboard->get_var("p", not_found), Variant(1));
+		CHECK_EQ(blackboard->get_var_handle("second"), first_handle + 1);
+
+		// * Memoized by a handle: name-based reads follow it through later changes.
+		const int handle_p = blackboard->get_var_handle("p");
+		parent_scope->set_var("q", 2);
+		parent_scope->erase_var("p");
+		CHECK_FALSE(blackboard->has_var("p"));
+		parent_scope->set_var("p", 3);
+		CHECK_EQ(blackboard->get_var("p", not_found), Variant(3));
+		CHECK_EQ(blackboard->get_var_by_handle(handle_p, not_found), Variant(3));
+	}
+	SUBCASE("Test handles after erasing variables in the scope chain") {
+		Ref<Blackboard> parent_scope = memnew(Blackboard);
+		parent_scope->set_var("p1", 1);
+		parent_scope->set_var("p2", 2);
+		parent_scope->set_var("p3", 3);
+		blackboard->set_parent(parent_scope);
+		const int handle_p3 = blackboard->get_var_handle("p3");
+		CHECK_EQ(blackboard->get_var_by_handle(handle_p3, not_found), Variant(3));
+
+		// * Changes in unrelated blackboards and in the current scope don't affect resolution.
+		Ref<Blackboard> unrelated = memnew(Blackboard);
+		unrelated->set_var("p3", 33);
+		blackboard->set_var("x", 0);
+		CHECK_EQ(blackboard->get_var_by_handle(handle_p3, not_found), Variant(3));
+
+		// * Variables that follow the erased one move, and the handle follows them.
+		parent_scope->erase_var("p1");
+		CHECK_EQ(blackboard->get_var_by_handle(handle_p3, not_found), Variant(3));
+		CHECK_EQ(blackboard->get_var("p2", not_found), Variant(2));
+		blackboard->set_var("p3", 4);
+		CHECK_EQ(blackboard->get_var_by_handle(handle_p3, not_found), Variant(4));
+		CHECK_EQ(parent_scope->list_vars().size(), 2);
+	}
 }
 
 } //namespace TestBlackboard
@@ -0,0 +1,456 @@
+/**
+ * test_bt_instance.h
+ * =============================================================================
+ * Copyright (c) 2023-present Serhii Snitsaruk and the LimboAI contributors.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#ifndef TEST_BT_INSTANCE_H
+#define TEST_BT_INSTANCE_H
+
+#include "limbo_test.h"
+
+#include "modules/limboai/bt/behavior_tree.h"
+#include "modules/limboai/bt/bt_instance.h"
+#include "modules/limboai/bt/tasks/bt_task.h"
+#include "modules/limboai/bt/tasks/bt_decorator.h"
+#include "modules/limboai/bt/tasks/composites/bt_dynamic_selector.h"
+#include "modules/limboai/bt/tasks/composites/bt_parallel.h"
+#include "modules/limboai/bt/tasks/composites/bt_selector.h"
+#include "modules/limboai/bt/tasks/composites/bt_sequence.h"
+#include "modules/limboai/bt/tasks/decorators/bt_invert.h"
+#include "modules/limboai/bt/tasks/utility/bt_fail.h"
+
+#include "core/object/message_queue.h"
+#include "core/os/os.h"
+
+namespace TestBTInstance {
+
+TEST_CASE("[Modules][LimboAI] BTInstance with resume_at_running_task") {
+	Node *dummy = memnew(Node);
+	Ref<Blackboard> bb = memnew(Blackboard);
+
+	SUBCASE("With pass-through composites") {
+		/** Hierarchy:
+		 *     seq->
+		 *         -> task1
+		 *         -> sel->
+		 *                -> task2
+		 *                -> task3
+		 *         -> task4
+		 */
+		Ref<BTSequence> seq = memnew(BTSequence);
+		Ref<BTSelector> sel = memnew(BTSelector);
+		Ref<BTTestAction> task1 = memnew(BTTestAction(BTTask::SUCCESS));
+		Ref<BTTestAction> task2 = memnew(BTTestAction(BTTask::FAILURE));
+		Ref<BTTestAction> task3 = memnew(BTTestAction(BTTask::RUNNING));
+		Ref<BTTestAction> task4 = memnew(BTTestAction(BTTask::SUCCESS));
+		seq->add_child(task1);
+		seq->add_child(sel);
+		seq->add_child(task4);
+		sel->add_child(task2);
+		sel->add_child(task3);
+		seq->initialize(dummy, bb, dummy);
+
+		Ref<BTInstance> inst = BTInstance::create(seq, "", dummy);
+		REQUIRE(inst.is_valid());
+		inst->set_resume_at_running_task(true);
+
+		CHECK(inst->update(0.1) == BTTask::RUNNING);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(task1, BTTask::SUCCESS, 1, 1, 1);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(task2, BTTask::FAILURE, 1, 1, 1);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(task3, BTTask::RUNNING, 1, 1, 0);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(task4, BTTask::FRESH, 0, 0, 0);
+
+		CHECK(inst->update(0.1) == BTTask::RUNNING);
+		CHECK(inst->update(0.1) == BTTask::RUNNING);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(task3, BTTask::RUNNING, 1, 3, 0);
+		// * Skipped ancestors must still accumulate elapsed time.
+		CHECK(seq->get_elapsed_time() == doctest::Approx(0.2));
+		CHECK(sel->get_elapsed_time() == doctest::Approx(0.2));
+		CHECK(task3->get_elapsed_time() == doctest::Approx(0.2));
+
+		SUBCASE("When the running task finishes") {
+			task3->ret_status = BTTask::SUCCESS;
+			CHECK(inst->update(0.1) == BTTask::SUCCESS);
+			CHECK_STATUS_ENTRIES_TICKS_EXITS(task1, BTTask::SUCCESS, 1, 1, 1);
+			CHECK_STATUS_ENTRIES_TICKS_EXITS(task2, BTTask::FAILURE, 1, 1, 1);
+			CHECK_STATUS_ENTRIES_TICKS_EXITS(task3, BTTask::SUCCESS, 1, 4, 1);
+			CHECK_STATUS_ENTRIES_TICKS_EXITS(task4, BTTask::SUCCESS, 1, 1, 1);
+			CHECK(sel->get_status() == BTTask::SUCCESS);
+			CHECK(seq->get_status() == BTTask::SUCCESS);
+		}
+		SUBCASE("When the tree is aborted") {
+			seq->abort();
+			CHECK(inst->update(0.1) == BTTask::RUNNING);
+			CHECK_STATUS_ENTRIES_TICKS_EXITS(task1, BTTask::SUCCESS, 2, 2, 2);
+			CHECK_STATUS_ENTRIES_TICKS_EXITS(task3, BTTask::RUNNING, 2, 4, 1);
+		}
+	}
+
+	SUBCASE("With a reactive composite") {
+		Ref<BTDynamicSelector> dsel = memnew(BTDynamicSelector);
+		Ref<BTTestAction> condition = memnew(BTTestAction(BTTask::FAILURE));
+		Ref<BTSequence> seq = memnew(BTSequence);
+		Ref<BTTestAction> task = memnew(BTTestAction(BTTask::RUNNING));
+		dsel->add_child(condition);
+		dsel->add_child(seq);
+		seq->add_child(task);
+		dsel->initialize(dummy, bb, dummy);
+
+		Ref<BTInstance> inst = BTInstance::create(dsel, "", dummy);
+		REQUIRE(inst.is_valid());
+		inst->set_resume_at_running_task(true);
+
+		CHECK(inst->update(0.1) == BTTask::RUNNING);
+		CHECK(inst->update(0.1) == BTTask::RUNNING);
+		// * Higher-priority child must be re-checked every update.
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(condition, BTTask::FAILURE, 2, 2, 2);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(task, BTTask::RUNNING, 1, 2, 0);
+
+		condition->ret_status = BTTask::SUCCESS;
+		CHECK(inst->update(0.1) == BTTask::SUCCESS);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(task, BTTask::FRESH, 1, 2, 1);
+	}
+
+	memdelete(dummy);
+}
+
+TEST_CASE("[Modules][LimboAI] BTInstance thread safety") {
+	Node *dummy = memnew(Node);
+	Ref<Blackboard> bb = memnew(Blackboard);
+
+	Ref<BTSequence> safe_root = memnew(BTSequence);
+	Ref<BTInvert> invert = memnew(BTInvert);
+	Ref<BTFail> fail = memnew(BTFail);
+	safe_root->add_child(invert);
+	invert->add_child(fail);
+	safe_root->initialize(dummy, bb, dummy);
+
+	Ref<BTSequence> unsafe_root = memnew(BTSequence);
+	Ref<BTTestAction> task = memnew(BTTestAction(BTTask::SUCCESS));
+	unsafe_root->add_child(task);
+	unsafe_root->initialize(dummy, bb, dummy);
+
+	CHECK_FALSE(BTInstance::create(safe_root->clone(), "", dummy)->is_thread_safe());
+	Ref<BTInstance> safe_inst = BTInstance::create(safe_root, "", dummy, true);
+	CHECK(safe_inst->is_thread_safe());
+	ERR_PRINT_OFF;
+	Ref<BTInstance> unsafe_inst = BTInstance::create(unsafe_root, "", dummy, true);
+	ERR_PRINT_ON;
+	CHECK_FALSE(unsafe_inst->is_thread_safe());
+
+	TypedArray<BTInstance> batch;
+	batch.push_back(safe_inst);
+	batch.push_back(unsafe_inst);
+	BTInstance::update_batch(batch, 0.1);
+	CHECK(safe_inst->get_last_status() == BTTask::SUCCESS);
+	CHECK(unsafe_inst->get_last_status() == BTTask::SUCCESS);
+	CHECK_STATUS_ENTRIES_TICKS_EXITS(task, BTTask::SUCCESS, 1, 1, 1);
+
+	SUBCASE("When the blackboard has a parent scope") {
+		bb->set_parent(memnew(Blackboard));
+		CHECK_FALSE(safe_inst->is_thread_safe());
+		bb->set_parent(nullptr);
+		CHECK(safe_inst->is_thread_safe());
+	}
+	SUBCASE("When a variable is linked") {
+		Ref<Blackboard> other = memnew(Blackboard);
+		other->set_var("shared", 1);
+		bb->link_var("shared", other, "shared", true);
+		CHECK_FALSE(safe_inst->is_thread_safe());
+		// * Either side dropping the link makes the scope private again.
+		other->erase_var("shared");
+		CHECK(safe_inst->is_thread_safe());
+	}
+	SUBCASE("When a variable is observed") {
+		bb->set_var("observed", 1);
+		const uint64_t id = bb->observe_var("observed", +[](void *p_userdata, const StringName &p_name, const Variant &p_value) {}, nullptr);
+		CHECK_FALSE(safe_inst->is_thread_safe());
+		bb->remove_observer(id);
+		CHECK(safe_inst->is_thread_safe());
+	}
+	SUBCASE("When a variable is bound") {
+		bb->bind_var_to_property("bound", dummy, "name", true);
+		CHECK_FALSE(safe_inst->is_thread_safe());
+		bb->unbind_var("bound");
+		CHECK(safe_inst->is_thread_safe());
+	}
+	SUBCASE("When the blackboard is used by another instance") {
+		Ref<BTSequence> other_root = safe_root->clone();
+		other_root->initialize(dummy, bb, dummy);
+		Ref<BTInstance> other_inst = BTInstance::create(other_root, "", dummy, true);
+		CHECK_FALSE(safe_inst->is_thread_safe());
+		CHECK_FALSE(other_inst->is_thread_safe());
+		other_inst.unref();
+		CHECK(safe_inst->is_thread_safe());
+	}
+
+	memdelete(dummy);
+}
+
+TEST_CASE("[Modules][LimboAI] BTInstance update callback") {
+	Node *dummy = memnew(Node);
+	Ref<Blackboard> bb = memnew(Blackboard);
+	Ref<BTTestAction> task = memnew(BTTestAction(BTTask::RUNNING));
+	task->initialize(dummy, bb, dummy);
+	Ref<BTInstance> inst = BTInstance::create(task, "", dummy);
+	inst->set_updated_signal_mode(BTInstance::SIGNAL_ON_STATUS_CHANGE);
+
+	int num_calls = 0;
+	inst->set_update_callback(+[](BTInstance *p_instance, BT::Status p_status, void *p_userdata) {
+		*static_cast<int *>(p_userdata) += 1;
+	},
+			&num_calls);
+	Ref<CallbackCounter> updated_counter = memnew(CallbackCounter);
+	inst->connect("updated", callable_mp(updated_counter.ptr(), &CallbackCounter::callback).unbind(1));
+#ifdef DEBUG_ENABLED
+	static int num_debugger_calls = 0;
+	num_debugger_calls = 0;
+	inst->set_debugger_callback(+[](BTInstance *p_instance, BT::Status p_status, void *p_userdata) {
+		num_debugger_calls += 1;
+	});
+#endif
+
+	inst->update(0.1);
+	CHECK(inst->is_status_changed());
+	inst->update(0.1);
+	CHECK_FALSE(inst->is_status_changed());
+	task->ret_status = BTTask::SUCCESS;
+	inst->update(0.1);
+	CHECK(inst->is_status_changed());
+	// * The callbacks are invoked regardless of the signal mode.
+	CHECK(num_calls == 3);
+	CHECK(updated_counter->num_callbacks == 2);
+#ifdef DEBUG_ENABLED
+	CHECK(num_debugger_calls == 3);
+	inst->set_debugger_callback(nullptr);
+#endif
+
+	inst->set_update_callback(nullptr);
+	memdelete(dummy);
+}
+
+// Pass-through decorator that counts its ticks.
+class BTTestPassThrough : public BTDecorator {
+	GDCLASS(BTTestPassThrough, BTDecorator);
+
+public:
+	int num_ticks = 0;
+
+protected:
+	virtual Status _tick(double p_delta) override {
+		num_ticks += 1;
+		return get_child(0)->execute(p_delta);
+	}
+	virtual bool _is_pass_through() const override { return true; }
+};
+
+TEST_CASE("[Modules][LimboAI] BTInstance with suspended tasks") {
+	Node *dummy = memnew(Node);
+	Ref<Blackboard> bb = memnew(Blackboard);
+	bb->set_var("flag", false);
+	Ref<BTSequence> seq = memnew(BTSequence);
+	Ref<BTTestAction> task = memnew(BTTestAction(BTTask::RUNNING));
+	seq->add_child(task);
+	seq->initialize(dummy, bb, dummy);
+	Ref<BTInstance> inst = BTInstance::create(seq, "", dummy);
+
+	Ref<CallbackCounter> resumed_counter = memnew(CallbackCounter);
+	inst->connect("resumed", callable_mp(resumed_counter.ptr(), &CallbackCounter::callback));
+
+	inst->update(0.1);
+	CHECK_STATUS_ENTRIES_TICKS_EXITS(task, BTTask::RUNNING, 1, 1, 0);
+	CHECK_FALSE(inst->is_suspended());
+
+	Ref<CallbackCounter> emitter = memnew(CallbackCounter);
+	emitter->add_user_signal(MethodInfo("wake", PropertyInfo(Variant::INT, "value")));
+	task->suspend_until(Signal(emitter.ptr(), "wake"));
+	CHECK(task->is_suspended());
+
+	// * The suspended task isn't ticked, and then the whole update is skipped.
+	inst->update(0.1);
+	CHECK_STATUS_ENTRIES_TICKS_EXITS(task, BTTask::RUNNING, 1, 1, 0);
+	CHECK(inst->is_suspended());
+	CHECK(inst->get_last_status() == BTTask::RUNNING);
+	inst->update(0.1);
+	CHECK_STATUS_ENTRIES_TICKS_EXITS(task, BTTask::RUNNING, 1, 1, 0);
+
+	// * Time still passes for the running path while the instance is asleep.
+	CHECK(task->get_elapsed_time() == doctest::Approx(0.2));
+	CHECK(seq->get_elapsed_time() == doctest::Approx(0.2));
+
+	SUBCASE("Sleep time reported by the owner") {
+		emitter->emit_signal("wake", 42);
+		inst->add_sleep_time(1.0);
+		CHECK(task->get_elapsed_time() == doctest::Approx(1.2));
+		CHECK(seq->get_elapsed_time() == doctest::Approx(1.2));
+	}
+
+	emitter->emit_signal("wake", 42);
+	CHECK_FALSE(task->is_suspended());
+	CHECK_FALSE(inst->is_suspended());
+	CHECK(resumed_counter->num_callbacks == 1);
+
+	inst->update(0.1);
+	CHECK_STATUS_ENTRIES_TICKS_EXITS(task, BTTask::RUNNING, 1, 2, 0);
+
+	SUBCASE("Abort ends suspension") {
+		task->suspend_until(Signal(emitter.ptr(), "wake"));
+		seq->abort();
+		CHECK_FALSE(task->is_suspended());
+		CHECK_FALSE(emitter->is_connected("wake", callable_mp(task.ptr(), &BTTask::resume).unbind(1)));
+	}
+
+	SUBCASE("Wake on a blackboard change") {
+		task->suspend_until_var_changed("flag");
+		inst->update(0.1);
+		CHECK(inst->is_suspended());
+		CHECK(resumed_counter->num_callbacks == 1);
+
+		bb->set_var("flag", true);
+		CHECK_FALSE(task->is_suspended());
+		CHECK_FALSE(inst->is_suspended());
+		CHECK(resumed_counter->num_callbacks == 2);
+
+		// * The observer is removed once woken.
+		task->suspend();
+		bb->set_var("flag", false);
+		CHECK(task->is_suspended());
+		task->resume();
+	}
+
+	memdelete(dummy);
+}
+
+TEST_CASE("[Modules][LimboAI] BTInstance with a suspended branch") {
+	Node *dummy = memnew(Node);
+	Ref<Blackboard> bb = memnew(Blackboard);
+	Ref<BTParallel> par = memnew(BTParallel);
+	Ref<BTTestAction> busy = memnew(BTTestAction(BTTask::RUNNING));
+	Ref<BTTestPassThrough> wrapper = memnew(BTTestPassThrough);
+	Ref<BTTestAction> sleeper = memnew(BTTestAction(BTTask::RUNNING));
+	par->add_child(busy);
+	par->add_child(wrapper);
+	wrapper->add_child(sleeper);
+	par->initialize(dummy, bb, dummy);
+	Ref<BTInstance> inst = BTInstance::create(par, "", dummy);
+
+	inst->update(0.1);
+	CHECK(wrapper->num_ticks == 1);
+	CHECK_STATUS_ENTRIES_TICKS_EXITS(sleeper, BTTask::RUNNING, 1, 1, 0);
+
+	// * The parallel keeps running, but the pass-through wrapper of the suspended task isn't ticked.
+	sleeper->suspend();
+	inst->update(0.1);
+	inst->update(0.1);
+	CHECK_FALSE(inst->is_suspended());
+	CHECK(busy->num_ticks == 3);
+	CHECK(wrapper->num_ticks == 1);
+	CHECK_STATUS_ENTRIES_TICKS_EXITS(sleeper, BTTask::RUNNING, 1, 1, 0);
+	CHECK(wrapper->get_elapsed_time() == doctest::Approx(0.2));
+	CHECK(sleeper->get_elapsed_time() == doctest::Approx(0.2));
+
+	sleeper->resume();
+	inst->update(0.1);
+	CHECK(wrapper->num_ticks == 2);
+	CHECK_STATUS_ENTRIES_TICKS_EXITS(sleeper, BTTask::RUNNING, 1, 2, 0);
+
+	memdelete(dummy);
+}
+
+TEST_CASE("[Modules][LimboAI] BTInstance loses a suspended task") {
+	Node *dummy = memnew(Node);
+	Ref<Blackboard> bb = memnew(Blackboard);
+	Ref<BTSequence> seq = memnew(BTSequence);
+	Ref<BTTestAction> task = memnew(BTTestAction(BTTask::RUNNING));
+	seq->add_child(task);
+	seq->initialize(dummy, bb, dummy);
+	Ref<BTInstance> inst = BTInstance::create(seq, "", dummy);
+
+	Ref<CallbackCounter> resumed_counter = memnew(CallbackCounter);
+	inst->connect("resumed", callable_mp(resumed_counter.ptr(), &CallbackCounter::callback));
+
+	inst->update(0.1);
+	task->suspend();
+	inst->update(0.1);
+	REQUIRE(inst->is_suspended());
+
+	// * Nothing is left to wake the instance once its suspended task is gone.
+	seq->remove_child(task);
+	CHECK_FALSE(inst->is_suspended());
+	CHECK(resumed_counter->num_callbacks == 1);
+
+	// * The removed task no longer reports to the instance.
+	task->resume();
+	CHECK(resumed_counter->num_callbacks == 1);
+	task.unref();
+
+	inst->update(0.1);
+	CHECK(inst->get_last_status() == BTTask::SUCCESS);
+
+	memdelete(dummy);
+}
+
+static Ref<BTInstance> async_result;
+static int async_num_calls = 0;
+
+static void _on_instantiated(const Ref<BTInstance> &p_instance) {
+	async_result = p_instance;
+	async_num_calls += 1;
+}
+
+TEST_CASE("[Modules][LimboAI] BehaviorTree::instantiate_async") {
+	Node *dummy = memnew(Node);
+	Ref<Blackboard> bb = memnew(Blackboard);
+	Ref<BehaviorTree> bt = memnew(BehaviorTree);
+	Ref<BTSequence> seq = memnew(BTSequence);
+	seq->add_child(memnew(BTFail));
+	bt->set_root_task(seq);
+
+	async_result.unref();
+	async_num_calls = 0;
+	bt->instantiate_async(dummy, bb, dummy, callable_mp_static(&_on_instantiated), dummy);
+
+	// * The instance is delivered through a deferred call once cloning is done.
+	for (int i = 0; i < 1000 && async_num_calls == 0; i++) {
+		OS::get_singleton()->delay_usec(1000);
+		MessageQueue::get_singleton()->flush();
+	}
+	REQUIRE(async_num_calls == 1);
+	REQUIRE(async_result.is_valid());
+	CHECK(async_result->get_root_task() != seq);
+	CHECK(async_result->get_agent() == dummy);
+	CHECK(async_result->get_blackboard() == bb);
+	CHECK(async_result->get_owner_node() == dummy);
+	CHECK(async_result->update(0.1) == BTTask::FAILURE);
+
+	SUBCASE("When the agent is freed before the tree is ready") {
+		Node *agent = memnew(Node);
+		async_result.unref();
+		async_num_calls = 0;
+		bt->instantiate_async(agent, bb, dummy, callable_mp_static(&_on_instantiated), dummy);
+		memdelete(agent);
+
+		// * The callback is still called, so the caller isn't left waiting.
+		ERR_PRINT_OFF;
+		for (int i = 0; i < 1000 && async_num_calls == 0; i++) {
+			OS::get_singleton()->delay_usec(1000);
+			MessageQueue::get_singleton()->flush();
+		}
+		ERR_PRINT_ON;
+		CHECK(async_num_calls == 1);
+		CHECK(async_result.is_null());
+	}
+
+	async_result.unref();
+	memdelete(dummy);
+}
+
+} //namespace TestBTInstance
+
+#endif // TEST_BT_INSTANCE_H
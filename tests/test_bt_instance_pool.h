@@ -0,0 +1,165 @@
+/**
+ * test_bt_instance_pool.h
+ * =============================================================================
+ * Copyright (c) 2023-present Serhii Snitsaruk and the LimboAI contributors.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#ifndef TEST_BT_INSTANCE_POOL_H
+#define TEST_BT_INSTANCE_POOL_H
+
+#include "limbo_test.h"
+
+#include "modules/limboai/bt/behavior_tree.h"
+#include "modules/limboai/bt/bt_instance_pool.h"
+#include "modules/limboai/bt/tasks/composites/bt_sequence.h"
+#include "modules/limboai/bt/tasks/decorators/bt_run_limit.h"
+#include "modules/limboai/bt/tasks/utility/bt_wait.h"
+
+namespace TestBTInstancePool {
+
+TEST_CASE("[Modules][LimboAI] BTInstancePool") {
+	Node *agent1 = memnew(Node);
+	Node *agent2 = memnew(Node);
+	Ref<Blackboard> bb1 = memnew(Blackboard);
+	Ref<Blackboard> bb2 = memnew(Blackboard);
+
+	Ref<BehaviorTree> bt = memnew(BehaviorTree);
+	Ref<BTSequence> seq = memnew(BTSequence);
+	Ref<BTWait> wait = memnew(BTWait);
+	wait->set_duration(10.0);
+	seq->add_child(wait);
+	bt->set_root_task(seq);
+
+	Ref<BTInstancePool> pool = memnew(BTInstancePool);
+	pool->set_behavior_tree(bt);
+	pool->prewarm(1);
+	CHECK(pool->get_available_count() == 1);
+
+	Ref<BTInstance> inst = pool->acquire(agent1, bb1, agent1, agent1);
+	REQUIRE(inst.is_valid());
+	CHECK(pool->get_hit_count() == 1);
+	CHECK(pool->get_miss_count() == 0);
+	CHECK(pool->get_available_count() == 0);
+	CHECK(inst->get_agent() == agent1);
+	CHECK(inst->update(0.1) == BTTask::RUNNING);
+
+	Ref<BTInstance> other = pool->acquire(agent2, bb2, agent2, agent2);
+	REQUIRE(other.is_valid());
+	CHECK(pool->get_miss_count() == 1);
+	CHECK(other->get_root_task() != inst->get_root_task());
+
+	SUBCASE("Recycled instance is reset and re-bound") {
+		pool->release(inst);
+		CHECK(pool->get_available_count() == 1);
+		CHECK(inst->get_root_task()->get_status() == BTTask::FRESH);
+
+		Ref<BTInstance> recycled = pool->acquire(agent2, bb2, agent2, agent2);
+		CHECK(recycled == inst);
+		CHECK(pool->get_hit_count() == 2);
+		CHECK(recycled->get_agent() == agent2);
+		CHECK(recycled->get_blackboard() == bb2);
+		CHECK(recycled->get_owner_node() == agent2);
+		CHECK(recycled->get_last_status() == BTTask::FRESH);
+		CHECK(recycled->update(0.1) == BTTask::RUNNING);
+	}
+
+	SUBCASE("Connections of the previous owner are removed") {
+		Ref<CallbackCounter> counter = memnew(CallbackCounter);
+		Callable callback = callable_mp(counter.ptr(), &CallbackCounter::callback);
+		inst->connect("resumed", callback);
+		pool->release(inst);
+		CHECK_FALSE(inst->is_connected("resumed", callback));
+	}
+
+	SUBCASE("Releasing twice is rejected") {
+		pool->release(inst);
+		ERR_PRINT_OFF;
+		pool->release(inst);
+		ERR_PRINT_ON;
+		CHECK(pool->get_available_count() == 1);
+	}
+
+	SUBCASE("Built-in trees are matched by the resource, not the path") {
+		Ref<BehaviorTree> other_bt = memnew(BehaviorTree);
+		other_bt->set_root_task(seq->clone());
+		Ref<BTInstance> foreign = other_bt->instantiate(agent1, bb1, agent1, agent1);
+		REQUIRE(foreign.is_valid());
+		CHECK(foreign->get_source_bt_path() == inst->get_source_bt_path());
+		ERR_PRINT_OFF;
+		pool->release(foreign);
+		ERR_PRINT_ON;
+		CHECK(pool->get_available_count() == 0);
+	}
+
+	SUBCASE("Trees with stateful tasks are cloned anew") {
+		Ref<BTRunLimit> limit = memnew(BTRunLimit);
+		limit->set_run_limit(1);
+		limit->add_child(memnew(BTTestAction(BTTask::SUCCESS)));
+		Ref<BehaviorTree> limited_bt = memnew(BehaviorTree);
+		limited_bt->set_root_task(limit);
+		pool->set_behavior_tree(limited_bt);
+
+		Ref<BTInstance> limited = pool->acquire(agent1, bb1, agent1, agent1);
+		REQUIRE(limited.is_valid());
+		CHECK(limited->update(0.1) == BTTask::SUCCESS);
+		CHECK(limited->update(0.1) == BTTask::FAILURE); // * Run limit reached.
+		pool->release(limited);
+		CHECK(pool->get_available_count() == 0);
+
+		Ref<BTInstance> fresh = pool->acquire(agent2, bb2, agent2, agent2);
+		REQUIRE(fresh.is_valid());
+		CHECK(fresh != limited);
+		CHECK(fresh->update(0.1) == BTTask::SUCCESS);
+	}
+
+	SUBCASE("Pooled trees are discarded when the tree changes") {
+		pool->release(inst);
+		pool->prewarm(1);
+		CHECK(pool->get_available_count() == 2);
+		bt->set_thread_safe(true); // * Emits "changed".
+		CHECK(pool->get_available_count() == 0);
+		// * Instances acquired before the change aren't pooled on release.
+		pool->release(other);
+		CHECK(pool->get_available_count() == 0);
+	}
+
+	SUBCASE("Pooled trees are discarded when a source task is edited") {
+		pool->release(inst);
+		wait->set_duration(5.0); // * Resets the runtime prototype.
+		Ref<BTInstance> fresh = pool->acquire(agent1, bb1, agent1, agent1);
+		REQUIRE(fresh.is_valid());
+		CHECK(fresh != inst);
+		CHECK(pool->get_miss_count() == 2);
+		Ref<BTWait> fresh_wait = fresh->get_root_task()->get_child(0);
+		CHECK(fresh_wait->get_duration() == doctest::Approx(5.0));
+	}
+
+	SUBCASE("Trees with a disabled root task are rejected") {
+		Ref<BTSequence> disabled_root = memnew(BTSequence);
+		disabled_root->set_enabled(false);
+		Ref<BehaviorTree> disabled_bt = memnew(BehaviorTree);
+		disabled_bt->set_root_task(disabled_root);
+		pool->set_behavior_tree(disabled_bt);
+		ERR_PRINT_OFF;
+		pool->prewarm(1);
+		CHECK(pool->acquire(agent1, bb1, agent1, agent1).is_null());
+		ERR_PRINT_ON;
+		CHECK(pool->get_available_count() == 0);
+	}
+
+	pool->reset_counters();
+	CHECK(pool->get_hit_count() == 0);
+	CHECK(pool->get_miss_count() == 0);
+
+	memdelete(agent1);
+	memdelete(agent2);
+}
+
+} //namespace TestBTInstancePool
+
+#endif // TEST_BT_INSTANCE_POOL_H
@@ -0,0 +1,125 @@
+/**
+ * test_bt_player.h
+ * =============================================================================
+ * Copyright (c) 2023-present Serhii Snitsaruk and the LimboAI contributors.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#ifndef TEST_BT_PLAYER_H
+#define TEST_BT_PLAYER_H
+
+#include "limbo_test.h"
+
+#include "modules/limboai/bt/behavior_tree.h"
+#include "modules/limboai/bt/bt_player.h"
+
+#include "scene/main/window.h"
+
+namespace TestBTPlayer {
+
+TEST_CASE("[SceneTree][LimboAI] BTPlayer with fixed tick rate") {
+	ClassDB::register_class<BTTestAction>();
+
+	Node *agent = memnew(Node);
+	SceneTree::get_singleton()->get_root()->add_child(agent);
+
+	Ref<BehaviorTree> bt = memnew(BehaviorTree);
+	bt->set_root_task(memnew(BTTestAction(BTTask::SUCCESS)));
+
+	BTPlayer *player = memnew(BTPlayer);
+	player->set_update_mode(BTPlayer::IDLE);
+	player->set_behavior_tree(bt);
+	player->set_scene_root_hint(agent);
+	player->set_fixed_tick_rate(10.0);
+	agent->add_child(player);
+
+	REQUIRE(player->get_bt_instance().is_valid());
+	Ref<BTTestAction> task = player->get_bt_instance()->get_root_task();
+	REQUIRE(task.is_valid());
+
+	// * 0.25s at 10 Hz: two steps, with half a step left over.
+	SceneTree::get_singleton()->process(0.25);
+	CHECK(task->num_ticks == 2);
+	CHECK(player->get_interpolation_alpha() == doctest::Approx(0.5));
+
+	SceneTree::get_singleton()->process(0.01);
+	CHECK(task->num_ticks == 2);
+
+	SceneTree::get_singleton()->process(0.1);
+	CHECK(task->num_ticks == 3);
+
+	SUBCASE("Catch-up is limited") {
+		player->set_fixed_max_steps(4);
+		SceneTree::get_singleton()->process(2.0);
+		CHECK(task->num_ticks == 7);
+		CHECK(player->get_interpolation_alpha() < 1.0);
+	}
+
+	SUBCASE("Disabled") {
+		player->set_fixed_tick_rate(0.0);
+		SceneTree::get_singleton()->process(0.01);
+		CHECK(task->num_ticks == 4);
+		CHECK(player->get_interpolation_alpha() == 1.0);
+	}
+
+	SUBCASE("Manual updates execute the tree once") {
+		player->set_update_mode(BTPlayer::MANUAL);
+		player->update(0.25);
+		CHECK(task->num_ticks == 4);
+		player->update(0.01);
+		CHECK(task->num_ticks == 5);
+		CHECK(player->get_interpolation_alpha() == doctest::Approx(0.6)); // * Unchanged.
+	}
+
+	memdelete(agent);
+}
+
+TEST_CASE("[SceneTree][LimboAI] BTPlayer with a suspended tree") {
+	ClassDB::register_class<BTTestAction>();
+
+	Node *agent = memnew(Node);
+	SceneTree::get_singleton()->get_root()->add_child(agent);
+
+	Ref<BehaviorTree> bt = memnew(BehaviorTree);
+	bt->set_root_task(memnew(BTTestAction(BTTask::RUNNING)));
+
+	BTPlayer *player = memnew(BTPlayer);
+	player->set_update_mode(BTPlayer::IDLE);
+	player->set_behavior_tree(bt);
+	player->set_scene_root_hint(agent);
+	agent->add_child(player);
+
+	REQUIRE(player->get_bt_instance().is_valid());
+	Ref<BTTestAction> task = player->get_bt_instance()->get_root_task();
+	REQUIRE(task.is_valid());
+
+	SceneTree::get_singleton()->process(0.1);
+	CHECK(task->num_ticks == 1);
+
+	task->suspend();
+	SceneTree::get_singleton()->process(0.1);
+	CHECK(player->get_bt_instance()->is_suspended());
+	CHECK_FALSE(player->is_processing());
+	CHECK(task->get_elapsed_time() == doctest::Approx(0.1));
+
+	// * The deltas the player would have received while paused are added on resume.
+	SceneTree::get_singleton()->process(0.25);
+	SceneTree::get_singleton()->process(0.5);
+	task->resume();
+	CHECK(player->is_processing());
+	CHECK(task->get_elapsed_time() == doctest::Approx(0.85));
+
+	SceneTree::get_singleton()->process(0.1);
+	CHECK(task->num_ticks == 2);
+	CHECK(task->get_elapsed_time() == doctest::Approx(0.95));
+
+	memdelete(agent);
+}
+
+} //namespace TestBTPlayer
+
+#endif // TEST_BT_PLAYER_H
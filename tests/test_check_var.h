@@ -91,6 +91,11 @@ TEST_CASE("[Modules][LimboAI] BTCheckVar") {
 			TC_CHECK_VALUES(cv, 3.0, 4.0, "3.0", LimboUtility::CHECK_LESS_THAN, 3.14);
 			TC_CHECK_VALUES(cv, 3.0, 3.14, "3.0", LimboUtility::CHECK_NOT_EQUAL, 3.14);
 		}
+		SUBCASE("With mixed integer and float") {
+			TC_CHECK_VALUES(cv, 3, 4, "3", LimboUtility::CHECK_LESS_THAN, 3.5);
+			TC_CHECK_VALUES(cv, 3.0, 3.5, "3", LimboUtility::CHECK_EQUAL, 3);
+			TC_CHECK_VALUES(cv, 3.5, 2.5, "3.5", LimboUtility::CHECK_GREATER_THAN, 3);
+		}
 		SUBCASE("With string") {
 			TC_CHECK_VALUES(cv, "AAA", "AAC", 123, LimboUtility::CHECK_EQUAL, "AAA");
 			TC_CHECK_VALUES(cv, "AAC", "AAA", 123, LimboUtility::CHECK_GREATER_THAN_OR_EQUAL, "AAB");
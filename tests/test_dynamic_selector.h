@@ -14,8 +14,11 @@
 
 #include "limbo_test.h"
 
+#include "modules/limboai/blackboard/bb_param/bb_variant.h"
+#include "modules/limboai/bt/tasks/blackboard/bt_check_var.h"
 #include "modules/limboai/bt/tasks/bt_task.h"
 #include "modules/limboai/bt/tasks/composites/bt_dynamic_selector.h"
+#include "modules/limboai/bt/tasks/composites/bt_sequence.h"
 
 namespace TestDynamicSelector {
 
@@ -116,6 +119,85 @@ TEST_CASE("[Modules][LimboAI] BTDynamicSelector") {
 	}
 }
 
+TEST_CASE("[Modules][LimboAI] BTDynamicSelector with observe_blackboard") {
+	Ref<BTDynamicSelector> sel = memnew(BTDynamicSelector);
+	sel->set_observe_blackboard(true);
+
+	// * Guard: succeeds when "alarm" equals true.
+	Ref<BTSequence> guard = memnew(BTSequence);
+	Ref<BTTestAction> guard_action = memnew(BTTestAction(BTTask::SUCCESS));
+	Ref<BTCheckVar> check = memnew(BTCheckVar);
+	Ref<BBVariant> value = memnew(BBVariant);
+	value->set_saved_value(true);
+	check->set_variable("alarm");
+	check->set_value(value);
+	check->set_check_type(LimboUtility::CHECK_EQUAL);
+	guard->add_child(guard_action);
+	guard->add_child(check);
+
+	Ref<BTTestAction> runner = memnew(BTTestAction(BTTask::RUNNING));
+	sel->add_child(guard);
+	sel->add_child(runner);
+
+	Ref<Blackboard> bb = memnew(Blackboard);
+	bb->set_var("alarm", false);
+	bb->set_var("unrelated", 0);
+	Ref<Blackboard> scope = memnew(Blackboard);
+	scope->set_parent(bb);
+	Node *dummy = memnew(Node);
+	sel->initialize(dummy, scope, dummy);
+
+	CHECK(sel->execute(0.01666) == BTTask::RUNNING);
+	CHECK_ENTRIES_TICKS_EXITS(guard_action, 1, 1, 1);
+	CHECK_ENTRIES_TICKS_EXITS(runner, 1, 1, 0);
+
+	SUBCASE("Guard is not re-evaluated while its variables are unchanged") {
+		bb->set_var("unrelated", 1);
+		CHECK(sel->execute(0.01666) == BTTask::RUNNING);
+		CHECK(sel->execute(0.01666) == BTTask::RUNNING);
+		CHECK_ENTRIES_TICKS_EXITS(guard_action, 1, 1, 1);
+		CHECK_ENTRIES_TICKS_EXITS(runner, 1, 3, 0);
+	}
+	SUBCASE("Guard is re-evaluated when its variable is written") {
+		bb->set_var("alarm", false);
+		CHECK(sel->execute(0.01666) == BTTask::RUNNING);
+		CHECK_ENTRIES_TICKS_EXITS(guard_action, 2, 2, 2);
+		CHECK_ENTRIES_TICKS_EXITS(runner, 1, 2, 0);
+
+		bb->set_var("alarm", true);
+		CHECK(sel->execute(0.01666) == BTTask::SUCCESS);
+		CHECK_ENTRIES_TICKS_EXITS(guard_action, 3, 3, 3);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(runner, BTTask::FRESH, 1, 2, 1); // * aborted
+	}
+	SUBCASE("Guard is re-evaluated when its variable is shadowed") {
+		scope->set_var("alarm", true);
+		CHECK(sel->execute(0.01666) == BTTask::SUCCESS);
+		CHECK_ENTRIES_TICKS_EXITS(guard_action, 2, 2, 2);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(runner, BTTask::FRESH, 1, 1, 1); // * aborted
+	}
+	SUBCASE("Guard is re-evaluated when a shadowing variable is erased") {
+		scope->set_var("alarm", false);
+		CHECK(sel->execute(0.01666) == BTTask::RUNNING);
+		CHECK_ENTRIES_TICKS_EXITS(guard_action, 2, 2, 2);
+
+		// * The shadowed variable is no longer read.
+		bb->set_var("alarm", true);
+		CHECK(sel->execute(0.01666) == BTTask::RUNNING);
+		CHECK_ENTRIES_TICKS_EXITS(guard_action, 2, 2, 2);
+
+		scope->erase_var("alarm");
+		CHECK(sel->execute(0.01666) == BTTask::SUCCESS);
+		CHECK_ENTRIES_TICKS_EXITS(guard_action, 3, 3, 3);
+	}
+	SUBCASE("Guard is re-evaluated every tick when observe_blackboard is disabled") {
+		sel->set_observe_blackboard(false);
+		CHECK(sel->execute(0.01666) == BTTask::RUNNING);
+		CHECK_ENTRIES_TICKS_EXITS(guard_action, 2, 2, 2);
+	}
+
+	memdelete(dummy);
+}
+
 } //namespace TestDynamicSelector
 
 #endif // TEST_DYNAMIC_SELECTOR_H
@@ -14,6 +14,8 @@
 
 #include "limbo_test.h"
 
+#include "modules/limboai/blackboard/bb_param/bb_variant.h"
+#include "modules/limboai/bt/tasks/blackboard/bt_check_var.h"
 #include "modules/limboai/bt/tasks/bt_task.h"
 #include "modules/limboai/bt/tasks/composites/bt_dynamic_sequence.h"
 
@@ -103,6 +105,40 @@ TEST_CASE("[Modules][LimboAI] BTDynamicSequence") {
 	}
 }
 
+TEST_CASE("[Modules][LimboAI] BTDynamicSequence with observe_blackboard") {
+	Ref<BTDynamicSequence> seq = memnew(BTDynamicSequence);
+	seq->set_observe_blackboard(true);
+
+	Ref<BTTestAction> task1 = memnew(BTTestAction(BTTask::SUCCESS));
+	Ref<BTCheckVar> check = memnew(BTCheckVar);
+	Ref<BBVariant> value = memnew(BBVariant);
+	value->set_saved_value(true);
+	check->set_variable("visible");
+	check->set_value(value);
+	check->set_check_type(LimboUtility::CHECK_EQUAL);
+	Ref<BTTestAction> runner = memnew(BTTestAction(BTTask::RUNNING));
+	seq->add_child(task1);
+	seq->add_child(check);
+	seq->add_child(runner);
+
+	Ref<Blackboard> bb = memnew(Blackboard);
+	bb->set_var("visible", true);
+	Node *dummy = memnew(Node);
+	seq->initialize(dummy, bb, dummy);
+
+	CHECK(seq->execute(0.01666) == BTTask::RUNNING);
+	CHECK(seq->execute(0.01666) == BTTask::RUNNING);
+	CHECK_ENTRIES_TICKS_EXITS(task1, 1, 1, 1); // * not re-evaluated
+	CHECK_ENTRIES_TICKS_EXITS(runner, 1, 2, 0);
+
+	bb->set_var("visible", false);
+	CHECK(seq->execute(0.01666) == BTTask::FAILURE);
+	CHECK_ENTRIES_TICKS_EXITS(task1, 2, 2, 2); // * re-evaluated
+	CHECK_STATUS_ENTRIES_TICKS_EXITS(runner, BTTask::FRESH, 1, 2, 1); // * aborted
+
+	memdelete(dummy);
+}
+
 } //namespace TestDynamicSequence
 
 #endif // TEST_DYNAMIC_SEQUENCE_H
@@ -205,6 +205,28 @@ TEST_CASE("[Modules][LimboAI] BTParallel with num_required_successes: 1 and num_
 		CHECK_ENTRIES_TICKS_EXITS(task2, 1, 3, 0); // * continued
 		CHECK_ENTRIES_TICKS_EXITS(task3, 2, 2, 2); // * repeated
 	}
+
+	SUBCASE("BTParallel resets its counters when aborted") {
+		task1->ret_status = BTTask::SUCCESS;
+		task2->ret_status = BTTask::RUNNING;
+		task3->ret_status = BTTask::RUNNING;
+		par->set_num_successes_required(2);
+		par->set_num_failures_required(2);
+		par->set_repeat(false);
+
+		CHECK(par->execute(0.01666) == BTTask::RUNNING);
+		CHECK(par->execute(0.01666) == BTTask::RUNNING);
+		CHECK_ENTRIES_TICKS_EXITS(task1, 1, 1, 1); // * finished, not visited again
+		CHECK_ENTRIES_TICKS_EXITS(task2, 1, 2, 0);
+
+		// * After abort, the success of task1 is counted only once.
+		par->abort();
+		CHECK(par->execute(0.01666) == BTTask::RUNNING);
+		CHECK_ENTRIES_TICKS_EXITS(task1, 2, 2, 2);
+
+		task3->ret_status = BTTask::SUCCESS;
+		CHECK(par->execute(0.01666) == BTTask::SUCCESS);
+	}
 }
 
 } //namespace TestParallel
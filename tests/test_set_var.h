@@ -138,6 +138,35 @@ TEST_CASE("[Modules][LimboAI] BTSetVar") {
 				CHECK(bb->get_var("var", 0) == Variant(5));
 			}
 		}
+		SUBCASE("When performing an operation on floats and vectors") {
+			value->set_value_source(BBParam::SAVED_VALUE);
+			sv->set_operation(LimboUtility::OPERATION_SUBTRACTION);
+
+			SUBCASE("Float") {
+				bb->set_var("var", 2.5);
+				value->set_saved_value(1.0);
+				CHECK(sv->execute(0.01666) == BTTask::SUCCESS);
+				CHECK(bb->get_var("var", 0) == Variant(1.5));
+			}
+			SUBCASE("Vector2") {
+				bb->set_var("var", Vector2(3, 4));
+				value->set_saved_value(Vector2(1, 1));
+				CHECK(sv->execute(0.01666) == BTTask::SUCCESS);
+				CHECK(bb->get_var("var", 0) == Variant(Vector2(2, 3)));
+			}
+			SUBCASE("Vector3") {
+				bb->set_var("var", Vector3(3, 4, 5));
+				value->set_saved_value(Vector3(1, 1, 1));
+				CHECK(sv->execute(0.01666) == BTTask::SUCCESS);
+				CHECK(bb->get_var("var", 0) == Variant(Vector3(2, 3, 4)));
+			}
+			SUBCASE("Mixed integer and float") {
+				bb->set_var("var", 3);
+				value->set_saved_value(0.5);
+				CHECK(sv->execute(0.01666) == BTTask::SUCCESS);
+				CHECK(bb->get_var("var", 0) == Variant(2.5));
+			}
+		}
 		SUBCASE("Performing an operation when assigned variable doesn't exist.") {
 			value->set_value_source(BBParam::SAVED_VALUE);
 			value->set_saved_value(3);
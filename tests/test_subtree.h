@@ -15,8 +15,11 @@
 #include "limbo_test.h"
 
 #include "modules/limboai/bt/behavior_tree.h"
+#include "modules/limboai/bt/bt_instance_pool.h"
 #include "modules/limboai/bt/tasks/bt_task.h"
+#include "modules/limboai/bt/tasks/composites/bt_sequence.h"
 #include "modules/limboai/bt/tasks/decorators/bt_subtree.h"
+#include "modules/limboai/bt/tasks/utility/bt_wait.h"
 
 namespace TestSubtree {
 
@@ -65,9 +68,99 @@ TEST_CASE("[Modules][LimboAI] BTSubtree") {
 		}
 	}
 
+	SUBCASE("With lazy instantiation") {
+		Ref<BehaviorTree> bt = memnew(BehaviorTree);
+		Ref<BTTestAction> task = memnew(BTTestAction(BTTask::SUCCESS));
+		bt->set_root_task(task);
+		st->set_subtree(bt);
+		st->set_lazy(true);
+
+		// * Nothing is cloned until the first entry.
+		st->initialize(dummy, bb, dummy);
+		CHECK(st->get_child_count() == 0);
+
+		CHECK(st->execute(0.01666) == BTTask::SUCCESS);
+		REQUIRE(st->get_child_count() == 1);
+		Ref<BTTestAction> ta = st->get_child(0);
+		REQUIRE(ta.is_valid());
+		CHECK(ta != task);
+		CHECK(ta->get_agent() == dummy);
+		CHECK(ta->get_blackboard()->get_parent() == bb);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(ta, BTTask::SUCCESS, 1, 1, 1);
+
+		CHECK(st->execute(0.01666) == BTTask::SUCCESS);
+		CHECK(st->get_child_count() == 1);
+		CHECK(st->get_child(0) == ta);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(ta, BTTask::SUCCESS, 2, 2, 2);
+
+		SUBCASE("In an instance") {
+			Ref<BTSequence> seq = memnew(BTSequence);
+			Ref<BTSubtree> lazy_st = memnew(BTSubtree);
+			Ref<BehaviorTree> wait_bt = memnew(BehaviorTree);
+			Ref<BTWait> wait = memnew(BTWait);
+			wait->set_duration(10.0);
+			wait_bt->set_root_task(wait);
+			lazy_st->set_subtree(wait_bt);
+			lazy_st->set_lazy(true);
+			seq->add_child(lazy_st);
+			Ref<BehaviorTree> outer_bt = memnew(BehaviorTree);
+			outer_bt->set_root_task(seq);
+
+			Ref<BTInstancePool> pool = memnew(BTInstancePool);
+			pool->set_behavior_tree(outer_bt);
+			Ref<BTInstance> inst = pool->acquire(dummy, bb, dummy, dummy);
+			REQUIRE(inst.is_valid());
+			Ref<BTTask> inst_st = inst->get_root_task()->get_child(0);
+			CHECK(inst_st->get_child_count() == 0);
+			CHECK(inst->update(0.1) == BTTask::RUNNING);
+			REQUIRE(inst_st->get_child_count() == 1);
+			Ref<BTTask> inst_wait = inst_st->get_child(0);
+			CHECK(inst_wait->get_status() == BTTask::RUNNING);
+
+			// * The next update recompiles the layout with the cloned subtree, which doesn't count
+			// as a modification: the instance is still pooled, and keeps its subtree.
+			CHECK(inst->update(0.1) == BTTask::RUNNING);
+			pool->release(inst);
+			CHECK(pool->get_available_count() == 1);
+			CHECK(pool->acquire(dummy, bb, dummy, dummy) == inst);
+			CHECK(inst_st->get_child(0) == inst_wait);
+			CHECK(inst->update(0.1) == BTTask::RUNNING);
+		}
+	}
+
 	memdelete(dummy);
 }
 
+TEST_CASE("[Modules][LimboAI] BehaviorTree runtime prototype") {
+	Ref<BehaviorTree> bt = memnew(BehaviorTree);
+	Ref<BTSequence> seq = memnew(BTSequence);
+	Ref<BTWait> wait = memnew(BTWait);
+	wait->set_duration(1.0);
+	seq->add_child(wait);
+	bt->set_root_task(seq);
+
+	Ref<BTTask> prototype = bt->get_runtime_prototype();
+	REQUIRE(prototype.is_valid());
+	CHECK(prototype != seq);
+	CHECK(bt->get_runtime_prototype() == prototype);
+
+	SUBCASE("Is rebuilt when a task property changes") {
+		wait->set_duration(2.0);
+		Ref<BTTask> rebuilt = bt->get_runtime_prototype();
+		CHECK(rebuilt != prototype);
+		Ref<BTWait> wait_copy = rebuilt->get_child(0);
+		REQUIRE(wait_copy.is_valid());
+		CHECK(wait_copy->get_duration() == 2.0);
+	}
+
+	SUBCASE("Is rebuilt when the hierarchy changes") {
+		seq->add_child(memnew(BTWait));
+		Ref<BTTask> rebuilt = bt->get_runtime_prototype();
+		CHECK(rebuilt != prototype);
+		CHECK(rebuilt->get_child_count() == 2);
+	}
+}
+
 } //namespace TestSubtree
 
 #endif // TEST_SUBTREE_H
@@ -14,7 +14,10 @@
 
 #include "limbo_test.h"
 
+#include "modules/limboai/blackboard/bb_param/bb_variant.h"
 #include "modules/limboai/blackboard/blackboard.h"
+#include "modules/limboai/bt/behavior_tree.h"
+#include "modules/limboai/bt/tasks/blackboard/bt_check_var.h"
 #include "modules/limboai/bt/tasks/bt_task.h"
 #include "tests/test_macros.h"
 
@@ -33,6 +36,8 @@ TEST_CASE("[Modules][LimboAI] BTTask") {
 		REQUIRE(task->get_child_count() == 2);
 		REQUIRE(task->get_child(0) == child1);
 		REQUIRE(task->get_child(1) == child3);
+		CHECK(task->get_child_ptr(0) == child1.ptr());
+		CHECK(task->get_child_ptr(1) == child3.ptr());
 		CHECK(child1->get_index() == 0);
 		CHECK(child3->get_index() == 1);
 
@@ -233,6 +238,149 @@ TEST_CASE("[Modules][LimboAI] BTTask") {
 		CHECK_FALSE(cloned->get_child(0) == child1);
 		CHECK_FALSE(cloned->get_child(1) == child2);
 	}
+
+	SUBCASE("Test editor properties") {
+		Ref<BTTestAction> task = memnew(BTTestAction);
+		CHECK(task->get_custom_name().is_empty());
+		CHECK_FALSE(task->is_displayed_collapsed());
+
+		task->set_custom_name("Custom");
+		task->set_display_collapsed(true);
+		CHECK(task->get_custom_name() == "Custom");
+		CHECK(task->get_task_name() == "Custom");
+		CHECK(task->is_displayed_collapsed());
+
+		Ref<BTTestAction> cloned = task->clone();
+		REQUIRE(cloned.is_valid());
+		CHECK(cloned->get_custom_name() == "Custom");
+		CHECK(cloned->is_displayed_collapsed());
+	}
+
+	SUBCASE("Test clone() with BBParam properties") {
+		Ref<BTCheckVar> task = memnew(BTCheckVar);
+		Ref<BBVariant> param = memnew(BBVariant);
+		param->set_value_source(BBParam::BLACKBOARD_VAR);
+		param->set_variable("var");
+		task->set_value(param);
+
+		// * Twice: the second clone uses the cached clone plan.
+		for (int i = 0; i < 2; i++) {
+			Ref<BTCheckVar> cloned = task->clone();
+			REQUIRE(cloned.is_valid());
+			REQUIRE(cloned->get_value().is_valid());
+			CHECK_FALSE(cloned->get_value() == param);
+			CHECK(cloned->get_value()->get_variable() == StringName("var"));
+		}
+	}
+
+	SUBCASE("Test clone() shares constant BBParams") {
+		Ref<BTCheckVar> task = memnew(BTCheckVar);
+		Ref<BBVariant> param = memnew(BBVariant);
+		param->set_value_source(BBParam::SAVED_VALUE);
+		param->set_saved_value(42);
+		task->set_value(param);
+
+		// * Plain clones duplicate every param.
+		Ref<BTCheckVar> cloned = task->clone();
+		REQUIRE(cloned.is_valid());
+		CHECK_FALSE(cloned->get_value() == param);
+
+		// * The runtime prototype owns its copies, which are shared by the clones made from it.
+		Ref<BehaviorTree> bt = memnew(BehaviorTree);
+		bt->set_root_task(task);
+		Ref<BTCheckVar> prototype = bt->get_runtime_prototype();
+		REQUIRE(prototype.is_valid());
+		CHECK_FALSE(prototype->get_value() == param);
+		Ref<BTCheckVar> clone1 = prototype->clone();
+		Ref<BTCheckVar> clone2 = prototype->clone();
+		REQUIRE(clone1.is_valid());
+		REQUIRE(clone2.is_valid());
+		CHECK(clone1->get_value() == prototype->get_value());
+		CHECK(clone2->get_value() == prototype->get_value());
+
+		prototype->get_value()->set_local_to_scene(true);
+		cloned = prototype->clone();
+		REQUIRE(cloned.is_valid());
+		CHECK_FALSE(cloned->get_value() == prototype->get_value());
+		CHECK(cloned->get_value()->get_saved_value() == Variant(42));
+	}
+
+	SUBCASE("Test abort() with compiled layout") {
+		Ref<BTTestAction> task = memnew(BTTestAction(BTTask::RUNNING));
+		Ref<BTTestAction> child1 = memnew(BTTestAction(BTTask::RUNNING));
+		Ref<BTTestAction> child2 = memnew(BTTestAction(BTTask::RUNNING));
+		Ref<BTTestAction> grandchild = memnew(BTTestAction(BTTask::RUNNING));
+		task->add_child(child1);
+		task->add_child(child2);
+		child1->add_child(grandchild);
+
+		BTCompiledTree compiled;
+		compiled.compile(task.ptr());
+		REQUIRE(compiled.size() == 4);
+		CHECK(compiled.get_node(0).subtree_end == 4);
+		CHECK(compiled.get_task(1) == child1.ptr());
+		CHECK(compiled.get_node(1).subtree_end == 3);
+		CHECK(compiled.get_node(2).parent == 1);
+		CHECK(compiled.get_task(3) == child2.ptr());
+
+		task->execute(0.01666);
+		child1->execute(0.01666);
+		child2->execute(0.01666);
+		grandchild->execute(0.01666);
+		CHECK(task->get_status() == BTTask::RUNNING);
+		CHECK(grandchild->get_status() == BTTask::RUNNING);
+
+		task->abort();
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(task, BTTask::FRESH, 1, 1, 1);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(child1, BTTask::FRESH, 1, 1, 1);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(child2, BTTask::FRESH, 1, 1, 1);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(grandchild, BTTask::FRESH, 1, 1, 1);
+
+		SUBCASE("When hierarchy changes after compilation") {
+			Ref<BTTestAction> child3 = memnew(BTTestAction(BTTask::RUNNING));
+			task->execute(0.01666);
+			task->execute(0.01666);
+			task->add_child(child3);
+			CHECK(compiled.is_dirty());
+			CHECK(task->get_status() == BTTask::RUNNING);
+			CHECK(task->get_elapsed_time() == doctest::Approx(0.01666));
+
+			task->execute(0.01666);
+			child3->execute(0.01666);
+			task->abort();
+			CHECK_STATUS_ENTRIES_TICKS_EXITS(task, BTTask::FRESH, 2, 4, 2);
+			CHECK_STATUS_ENTRIES_TICKS_EXITS(child3, BTTask::FRESH, 1, 1, 1);
+		}
+
+		SUBCASE("When a branch is compiled into another layout") {
+			BTCompiledTree other;
+			other.compile(child1.ptr());
+			CHECK(compiled.is_dirty());
+			REQUIRE(other.size() == 2);
+			CHECK(other.get_task(1) == grandchild.ptr());
+
+			child1->execute(0.01666);
+			grandchild->execute(0.01666);
+			child1->abort();
+			CHECK(grandchild->get_status() == BTTask::FRESH);
+		}
+
+		SUBCASE("When the layout is shared") {
+			Ref<BTTask> copy = task->clone();
+			BTCompiledTree shared;
+			shared.compile(copy.ptr(), compiled.get_layout());
+			CHECK(shared.ptr() == compiled.ptr());
+			CHECK(shared.get_task(3) == copy->get_child_ptr(1));
+
+			// * A different hierarchy gets its own structure.
+			copy->get_child(1)->add_child(memnew(BTTestAction));
+			shared.compile(copy.ptr(), compiled.get_layout());
+			CHECK(shared.ptr() != compiled.ptr());
+			REQUIRE(shared.size() == 5);
+			CHECK(shared.get_node(3).subtree_end == 5);
+			CHECK(shared.get_node(4).parent == 3);
+		}
+	}
 }
 
 } //namespace TestTask
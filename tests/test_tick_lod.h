@@ -0,0 +1,60 @@
+/**
+ * test_tick_lod.h
+ * =============================================================================
+ * Copyright (c) 2023-present Serhii Snitsaruk and the LimboAI contributors.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#ifndef TEST_TICK_LOD_H
+#define TEST_TICK_LOD_H
+
+#include "limbo_test.h"
+
+#include "modules/limboai/util/limbo_tick_lod.h"
+#include "modules/limboai/util/limbo_tick_server.h"
+
+namespace TestTickLOD {
+
+TEST_CASE("[Modules][LimboAI] LimboTickLOD") {
+	REQUIRE(LimboTickServer::get_singleton() != nullptr);
+	Node *dummy = memnew(Node);
+	LimboTickLOD lod;
+	double delta = 0.0;
+
+	CHECK_FALSE(lod.is_enabled());
+	CHECK(lod.advance(0.1, dummy, dummy, delta));
+	CHECK(delta == doctest::Approx(0.1));
+
+	SUBCASE("Skips frames and accumulates delta") {
+		lod.set_level(1);
+		CHECK(lod.is_enabled());
+		const int interval = LimboTickServer::get_singleton()->get_lod_interval(1);
+		REQUIRE(interval > 1);
+		// * The new level takes effect after the next update.
+		CHECK(lod.advance(0.1, dummy, dummy, delta));
+		int updates = 0;
+		for (int i = 0; i < interval * 3; i++) {
+			if (lod.advance(0.1, dummy, dummy, delta)) {
+				updates += 1;
+				CHECK(delta == doctest::Approx(0.1 * interval));
+			}
+		}
+		CHECK(updates == 3);
+	}
+
+	SUBCASE("Level from callable") {
+		lod.set_level_callback(callable_mp_static(+[]() { return 2; }));
+		CHECK(lod.advance(0.1, dummy, dummy, delta));
+		CHECK(lod.get_level() == 2);
+	}
+
+	memdelete(dummy);
+}
+
+} //namespace TestTickLOD
+
+#endif // TEST_TICK_LOD_H
@@ -0,0 +1,353 @@
+/**
+ * test_tick_server.h
+ * =============================================================================
+ * Copyright (c) 2023-present Serhii Snitsaruk and the LimboAI contributors.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#ifndef TEST_TICK_SERVER_H
+#define TEST_TICK_SERVER_H
+
+#include "limbo_test.h"
+
+#include "modules/limboai/bt/behavior_tree.h"
+#include "modules/limboai/bt/bt_player.h"
+#include "modules/limboai/bt/tasks/utility/bt_wait_ticks.h"
+#include "modules/limboai/hsm/limbo_hsm.h"
+#include "modules/limboai/hsm/limbo_state.h"
+#include "modules/limboai/util/limbo_tick_server.h"
+
+#include "core/config/project_settings.h"
+#include "core/os/os.h"
+#include "scene/main/window.h"
+
+namespace TestTickServer {
+
+static LocalVector<Node *> tick_log;
+static LocalVector<double> delta_log;
+
+static void log_tick(Node *p_node, double p_delta) {
+	tick_log.push_back(p_node);
+	delta_log.push_back(p_delta);
+}
+
+static void log_slow_tick(Node *p_node, double p_delta) {
+	log_tick(p_node, p_delta);
+	// * Exceed any tiny budget.
+	OS::get_singleton()->delay_usec(100);
+}
+
+static bool prepare_threaded(Node *p_node, double p_delta) {
+	return true;
+}
+
+static void run_threaded(Node *p_node) {
+}
+
+static void finish_threaded(Node *p_node) {
+	tick_log.push_back(p_node);
+}
+
+static const LimboTickServer::ThreadedCallbacks log_threaded_callbacks = {
+	&prepare_threaded,
+	&run_threaded,
+	&finish_threaded,
+};
+
+// The tick server reads its settings once, when it's created.
+static void restart_tick_server(bool p_enabled, double p_budget_msec = 2.0) {
+	ProjectSettings::get_singleton()->set_setting("limbo_ai/tick_server/enabled", p_enabled);
+	ProjectSettings::get_singleton()->set_setting("limbo_ai/tick_server/budget_msec", p_budget_msec);
+	LimboTickServer::deinitialize();
+	LimboTickServer::initialize();
+	REQUIRE(LimboTickServer::is_enabled() == p_enabled);
+}
+
+TEST_CASE("[SceneTree][LimboAI] LimboTickServer tick order") {
+	restart_tick_server(true);
+	LimboTickServer *server = LimboTickServer::get_singleton();
+	Window *root = SceneTree::get_singleton()->get_root();
+	Node *first = memnew(Node);
+	Node *second = memnew(Node);
+	Node *threaded = memnew(Node);
+	root->add_child(first);
+	root->add_child(second);
+	root->add_child(threaded);
+	tick_log.clear();
+
+	server->register_node(first, LimboTickServer::TICK_IDLE, &log_tick);
+	server->register_node(second, LimboTickServer::TICK_IDLE, &log_tick);
+	server->register_node(threaded, LimboTickServer::TICK_IDLE, &log_tick, &log_threaded_callbacks);
+	CHECK(server->get_node_count() == 3);
+
+	// * Threaded entries come first, then the rest in registration order.
+	SceneTree::get_singleton()->process(0.1);
+	REQUIRE(tick_log.size() == 3);
+	CHECK(tick_log[0] == threaded);
+	CHECK(tick_log[1] == first);
+	CHECK(tick_log[2] == second);
+
+	SUBCASE("Re-registered nodes move to the end") {
+		server->unregister_node(first);
+		CHECK_FALSE(server->is_node_registered(first));
+		server->register_node(first, LimboTickServer::TICK_IDLE, &log_tick);
+		tick_log.clear();
+		SceneTree::get_singleton()->process(0.1);
+		REQUIRE(tick_log.size() == 3);
+		CHECK(tick_log[0] == threaded);
+		CHECK(tick_log[1] == second);
+		CHECK(tick_log[2] == first);
+	}
+
+	SUBCASE("Groups are ticked by their own frames") {
+		server->register_node(second, LimboTickServer::TICK_PHYSICS, &log_tick);
+		tick_log.clear();
+		SceneTree::get_singleton()->process(0.1);
+		REQUIRE(tick_log.size() == 2);
+		CHECK(tick_log[0] == threaded);
+		CHECK(tick_log[1] == first);
+
+		tick_log.clear();
+		SceneTree::get_singleton()->physics_process(0.1);
+		REQUIRE(tick_log.size() == 1);
+		CHECK(tick_log[0] == second);
+	}
+
+	server->unregister_node(first);
+	server->unregister_node(second);
+	server->unregister_node(threaded);
+	memdelete(first);
+	memdelete(second);
+	memdelete(threaded);
+	restart_tick_server(false);
+}
+
+TEST_CASE("[SceneTree][LimboAI] LimboTickServer budgeted group") {
+	restart_tick_server(true, 0.001);
+	LimboTickServer *server = LimboTickServer::get_singleton();
+	Window *root = SceneTree::get_singleton()->get_root();
+	Node *low1 = memnew(Node);
+	Node *low2 = memnew(Node);
+	Node *high = memnew(Node);
+	root->add_child(low1);
+	root->add_child(low2);
+	root->add_child(high);
+	server->register_node(low1, LimboTickServer::TICK_BUDGETED, &log_slow_tick);
+	server->register_node(low2, LimboTickServer::TICK_BUDGETED, &log_slow_tick);
+	server->register_node(high, LimboTickServer::TICK_BUDGETED, &log_slow_tick);
+	server->set_node_priority(high, 2.5);
+	tick_log.clear();
+	delta_log.clear();
+
+	// * With the budget exceeded by the first tick, only the top-scoring node is ticked each frame.
+	// Score is the pending delta multiplied by the priority.
+	const int num_frames = 5;
+	for (int i = 0; i < num_frames; i++) {
+		SceneTree::get_singleton()->process(0.1);
+	}
+	REQUIRE(tick_log.size() == num_frames);
+	// Frame 1: 0.1, 0.1, 0.25
+	CHECK(tick_log[0] == high);
+	CHECK(delta_log[0] == doctest::Approx(0.1));
+	// Frame 2: 0.2, 0.2, 0.25
+	CHECK(tick_log[1] == high);
+	CHECK(delta_log[1] == doctest::Approx(0.1));
+	// Frame 3: 0.3, 0.3, 0.25 - ties are broken by registration order.
+	CHECK(tick_log[2] == low1);
+	CHECK(delta_log[2] == doctest::Approx(0.3));
+	// Frame 4: 0.1, 0.4, 0.5
+	CHECK(tick_log[3] == high);
+	CHECK(delta_log[3] == doctest::Approx(0.2));
+	// Frame 5: 0.2, 0.5, 0.25 - deferred nodes aren't starved, and receive all of the accumulated time.
+	CHECK(tick_log[4] == low2);
+	CHECK(delta_log[4] == doctest::Approx(0.5));
+
+	SUBCASE("With a sufficient budget") {
+		restart_tick_server(true, 1000.0);
+		server = LimboTickServer::get_singleton();
+		server->register_node(low1, LimboTickServer::TICK_BUDGETED, &log_tick);
+		server->register_node(low2, LimboTickServer::TICK_BUDGETED, &log_tick);
+		server->register_node(high, LimboTickServer::TICK_BUDGETED, &log_tick);
+		tick_log.clear();
+		delta_log.clear();
+		SceneTree::get_singleton()->process(0.1);
+		REQUIRE(tick_log.size() == 3);
+		CHECK(delta_log[0] == doctest::Approx(0.1));
+		CHECK(delta_log[1] == doctest::Approx(0.1));
+		CHECK(delta_log[2] == doctest::Approx(0.1));
+	}
+
+	server->unregister_node(low1);
+	server->unregister_node(low2);
+	server->unregister_node(high);
+	memdelete(low1);
+	memdelete(low2);
+	memdelete(high);
+	restart_tick_server(false);
+}
+
+TEST_CASE("[SceneTree][LimboAI] LimboTickServer with BTPlayer") {
+	ClassDB::register_class<BTTestAction>();
+
+	Node *agent = memnew(Node);
+	SceneTree::get_singleton()->get_root()->add_child(agent);
+
+	Ref<BehaviorTree> bt = memnew(BehaviorTree);
+	bt->set_root_task(memnew(BTTestAction(BTTask::RUNNING)));
+
+	SUBCASE("When enabled") {
+		restart_tick_server(true);
+		LimboTickServer *server = LimboTickServer::get_singleton();
+
+		BTPlayer *player = memnew(BTPlayer);
+		player->set_update_mode(BTPlayer::IDLE);
+		player->set_behavior_tree(bt);
+		player->set_scene_root_hint(agent);
+		agent->add_child(player);
+		REQUIRE(player->get_bt_instance().is_valid());
+		Ref<BTTestAction> task = player->get_bt_instance()->get_root_task();
+
+		// * Registered on ENTER_TREE instead of using process notifications.
+		CHECK(server->is_node_registered(player));
+		CHECK_FALSE(player->is_processing());
+		SceneTree::get_singleton()->process(0.1);
+		CHECK(task->num_ticks == 1);
+
+		// * Unregistered on EXIT_TREE.
+		agent->remove_child(player);
+		CHECK_FALSE(server->is_node_registered(player));
+		agent->add_child(player);
+		CHECK(server->is_node_registered(player));
+
+		player->set_active(false);
+		CHECK_FALSE(server->is_node_registered(player));
+		SceneTree::get_singleton()->process(0.1);
+		CHECK(task->num_ticks == 1);
+		player->set_active(true);
+		CHECK(server->is_node_registered(player));
+
+		memdelete(player);
+		CHECK_FALSE(server->is_node_registered(player));
+		CHECK(server->get_node_count() == 0);
+	}
+
+	SUBCASE("When disabled") {
+		restart_tick_server(false);
+
+		BTPlayer *player = memnew(BTPlayer);
+		player->set_update_mode(BTPlayer::IDLE);
+		player->set_behavior_tree(bt);
+		player->set_scene_root_hint(agent);
+		agent->add_child(player);
+		REQUIRE(player->get_bt_instance().is_valid());
+		Ref<BTTestAction> task = player->get_bt_instance()->get_root_task();
+
+		CHECK_FALSE(LimboTickServer::get_singleton()->is_node_registered(player));
+		CHECK(player->is_processing());
+		SceneTree::get_singleton()->process(0.1);
+		CHECK(task->num_ticks == 1);
+
+		memdelete(player);
+	}
+
+	memdelete(agent);
+	restart_tick_server(false);
+}
+
+// Returns the number of updates a player at LOD level 1 receives over p_frames frames.
+static int count_lod_updates(const Ref<BehaviorTree> &p_bt, BTPlayer::UpdateMode p_mode, Node *p_agent, int p_frames) {
+	BTPlayer *player = memnew(BTPlayer);
+	player->set_update_mode(p_mode);
+	player->set_behavior_tree(p_bt);
+	player->set_scene_root_hint(p_agent);
+	player->set_lod_level(1);
+	p_agent->add_child(player);
+	REQUIRE(player->get_bt_instance().is_valid());
+	CHECK(player->get_bt_instance()->is_thread_safe() == p_bt->is_thread_safe());
+
+	Ref<CallbackCounter> counter = memnew(CallbackCounter);
+	player->connect("updated", callable_mp(counter.ptr(), &CallbackCounter::callback).unbind(1));
+	for (int i = 0; i < p_frames; i++) {
+		SceneTree::get_singleton()->process(0.1);
+	}
+	memdelete(player);
+	return counter->num_callbacks;
+}
+
+TEST_CASE("[SceneTree][LimboAI] LimboTickServer with BTPlayer LOD") {
+	restart_tick_server(true, 1000.0);
+	const int interval = LimboTickServer::get_singleton()->get_lod_interval(1);
+	REQUIRE(interval > 1);
+	const int num_frames = interval * 3;
+
+	Node *agent = memnew(Node);
+	SceneTree::get_singleton()->get_root()->add_child(agent);
+
+	// * LOD follows the same rule whether the player is updated on the main thread or on worker threads:
+	// it skips frames in IDLE mode, and is ignored in BUDGETED mode.
+	SUBCASE("On the main thread") {
+		ClassDB::register_class<BTTestAction>();
+		Ref<BehaviorTree> bt = memnew(BehaviorTree);
+		bt->set_root_task(memnew(BTTestAction(BTTask::RUNNING)));
+		CHECK(count_lod_updates(bt, BTPlayer::IDLE, agent, num_frames) == 3);
+		CHECK(count_lod_updates(bt, BTPlayer::BUDGETED, agent, num_frames) == num_frames);
+	}
+	SUBCASE("On worker threads") {
+		Ref<BTWaitTicks> wait = memnew(BTWaitTicks);
+		wait->set_num_ticks(1000);
+		Ref<BehaviorTree> bt = memnew(BehaviorTree);
+		bt->set_root_task(wait);
+		bt->set_thread_safe(true);
+		CHECK(count_lod_updates(bt, BTPlayer::IDLE, agent, num_frames) == 3);
+		CHECK(count_lod_updates(bt, BTPlayer::BUDGETED, agent, num_frames) == num_frames);
+	}
+
+	memdelete(agent);
+	restart_tick_server(false);
+}
+
+TEST_CASE("[SceneTree][LimboAI] LimboTickServer with LimboHSM") {
+	restart_tick_server(true);
+	LimboTickServer *server = LimboTickServer::get_singleton();
+
+	Node *agent = memnew(Node);
+	SceneTree::get_singleton()->get_root()->add_child(agent);
+	Ref<CallbackCounter> updates = memnew(CallbackCounter);
+
+	LimboHSM *hsm = memnew(LimboHSM);
+	hsm->set_update_mode(LimboHSM::IDLE);
+	LimboState *state = memnew(LimboState);
+	state->call_on_update(callable_mp(updates.ptr(), &CallbackCounter::callback_delta));
+	hsm->add_child(state);
+	hsm->set_initial_state(state);
+	agent->add_child(hsm);
+	hsm->initialize(agent);
+	hsm->set_active(true);
+
+	CHECK(server->is_node_registered(hsm));
+	CHECK_FALSE(hsm->is_processing());
+	SceneTree::get_singleton()->process(0.1);
+	CHECK(updates->num_callbacks == 1);
+
+	agent->remove_child(hsm);
+	CHECK_FALSE(server->is_node_registered(hsm));
+	// * Stays active while reparented, and is registered again on ENTER_TREE.
+	agent->add_child(hsm);
+	CHECK(server->is_node_registered(hsm));
+	SceneTree::get_singleton()->process(0.1);
+	CHECK(updates->num_callbacks == 2);
+
+	hsm->set_active(false);
+	CHECK_FALSE(server->is_node_registered(hsm));
+
+	memdelete(agent);
+	restart_tick_server(false);
+}
+
+} //namespace TestTickServer
+
+#endif // TEST_TICK_SERVER_H
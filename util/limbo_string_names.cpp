@@ -110,9 +110,11 @@ LimboStringNames::LimboStringNames() {
 	NonFavorite = SN("NonFavorite");
 	normal = SN("normal");
 	panel = SN("panel");
+	physics_frame = SN("physics_frame");
 	plan_changed = SN("plan_changed");
 	popup_hide = SN("popup_hide");
 	pressed = SN("pressed");
+	process_frame = SN("process_frame");
 	probability_clicked = SN("probability_clicked");
 	property_changed = SN("property_changed");
 	Reload = SN("Reload");
@@ -120,6 +122,7 @@ LimboStringNames::LimboStringNames() {
 	remove_child = SN("remove_child");
 	Rename = SN("Rename");
 	request_open_in_screen = SN("request_open_in_screen");
+	resumed = SN("resumed");
 	rmb_pressed = SN("rmb_pressed");
 	Save = SN("Save");
 	saved_value = SN("saved_value");
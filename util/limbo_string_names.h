@@ -129,9 +129,11 @@ public:
 	StringName NonFavorite;
 	StringName normal;
 	StringName panel;
+	StringName physics_frame;
 	StringName plan_changed;
 	StringName popup_hide;
 	StringName pressed;
+	StringName process_frame;
 	StringName probability_clicked;
 	StringName property_changed;
 	StringName Reload;
@@ -139,6 +141,7 @@ public:
 	StringName Remove;
 	StringName Rename;
 	StringName request_open_in_screen;
+	StringName resumed;
 	StringName rmb_pressed;
 	StringName Save;
 	StringName saved_value;
@@ -0,0 +1,114 @@
+/**
+ * limbo_tick_lod.cpp
+ * =============================================================================
+ * Copyright (c) 2023-present Serhii Snitsaruk and the LimboAI contributors.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#include "limbo_tick_lod.h"
+
+#include "limbo_tick_server.h"
+
+#ifdef LIMBOAI_MODULE
+#include "scene/2d/camera_2d.h"
+#include "scene/2d/node_2d.h"
+#include "scene/3d/node_3d.h"
+#include "scene/main/viewport.h"
+#ifndef _3D_DISABLED
+#include "scene/3d/camera_3d.h"
+#endif // _3D_DISABLED
+#endif // LIMBOAI_MODULE
+
+#ifdef LIMBOAI_GDEXTENSION
+#include <godot_cpp/classes/camera2d.hpp>
+#include <godot_cpp/classes/camera3d.hpp>
+#include <godot_cpp/classes/node2d.hpp>
+#include <godot_cpp/classes/node3d.hpp>
+#include <godot_cpp/classes/viewport.hpp>
+#endif // LIMBOAI_GDEXTENSION
+
+static bool _get_global_position(Node *p_node, Vector3 &r_position) {
+	if (Node3D *node_3d = Object::cast_to<Node3D>(p_node)) {
+		r_position = node_3d->get_global_position();
+		return true;
+	}
+	if (Node2D *node_2d = Object::cast_to<Node2D>(p_node)) {
+		Vector2 pos = node_2d->get_global_position();
+		r_position = Vector3(pos.x, pos.y, 0.0);
+		return true;
+	}
+	return false;
+}
+
+Node *LimboTickLOD::_get_reference_node(Node *p_owner) const {
+	if (!reference_node.is_empty()) {
+		return p_owner->get_node_or_null(reference_node);
+	}
+	Viewport *viewport = p_owner->get_viewport();
+	if (viewport == nullptr) {
+		return nullptr;
+	}
+#if defined(LIMBOAI_GDEXTENSION) || !defined(_3D_DISABLED)
+	if (Camera3D *camera_3d = viewport->get_camera_3d()) {
+		return camera_3d;
+	}
+#endif
+	return viewport->get_camera_2d();
+}
+
+int LimboTickLOD::_evaluate_level(Node *p_owner, Node *p_agent) const {
+	if (level_callback.is_valid()) {
+		return level_callback.call();
+	}
+	if (distances.is_empty()) {
+		return level;
+	}
+
+	Node *reference = _get_reference_node(p_owner);
+	Vector3 agent_pos;
+	Vector3 reference_pos;
+	if (reference == nullptr || !_get_global_position(p_agent, agent_pos) || !_get_global_position(reference, reference_pos)) {
+		return 0;
+	}
+	// * Level is the number of distance thresholds exceeded.
+	const real_t dist_sq = agent_pos.distance_squared_to(reference_pos);
+	int new_level = 0;
+	for (int i = 0; i < distances.size(); i++) {
+		if (dist_sq < distances[i] * distances[i]) {
+			break;
+		}
+		new_level += 1;
+	}
+	return new_level;
+}
+
+bool LimboTickLOD::advance(double p_delta, Node *p_owner, Node *p_agent, double &r_delta) {
+	accumulated_delta += p_delta;
+	if (frames_until_update > 1) {
+		frames_until_update -= 1;
+		return false;
+	}
+
+	r_delta = accumulated_delta;
+	accumulated_delta = 0.0;
+	if (p_agent) {
+		level = MAX(0, _evaluate_level(p_owner, p_agent));
+	}
+	frames_until_update = LimboTickServer::get_singleton()->get_lod_interval(level);
+	return true;
+}
+
+void LimboTickLOD::reset() {
+	frames_until_update = 0;
+	accumulated_delta = 0.0;
+}
+
+void LimboTickLOD::set_level(int p_level) {
+	level = MAX(0, p_level);
+	// * Apply the new rate right away, rather than after the current interval.
+	frames_until_update = MIN(frames_until_update, LimboTickServer::get_singleton()->get_lod_interval(level));
+}
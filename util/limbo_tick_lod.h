@@ -0,0 +1,69 @@
+/**
+ * limbo_tick_lod.h
+ * =============================================================================
+ * Copyright (c) 2023-present Serhii Snitsaruk and the LimboAI contributors.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#ifndef LIMBO_TICK_LOD_H
+#define LIMBO_TICK_LOD_H
+
+#ifdef LIMBOAI_MODULE
+#include "core/variant/callable.h"
+#include "core/variant/variant.h"
+#include "scene/main/node.h"
+#endif // LIMBOAI_MODULE
+
+#ifdef LIMBOAI_GDEXTENSION
+#include <godot_cpp/classes/node.hpp>
+#include <godot_cpp/variant/callable.hpp>
+#include <godot_cpp/variant/node_path.hpp>
+#include <godot_cpp/variant/packed_float32_array.hpp>
+using namespace godot;
+#endif // LIMBOAI_GDEXTENSION
+
+// Tick-rate level of detail for automatically updated nodes (BTPlayer, LimboHSM).
+// Each LOD level maps to an update interval in frames ("limbo_ai/tick_lod/intervals"
+// project setting); the delta is accumulated over the skipped frames.
+// The level is chosen, in order of precedence, by a user callback, by distance from
+// the agent to a reference node (the current camera by default), or set directly.
+// It is re-evaluated after each update.
+class LimboTickLOD {
+private:
+	int level = 0;
+	Callable level_callback;
+	PackedFloat32Array distances;
+	NodePath reference_node;
+
+	int frames_until_update = 0;
+	double accumulated_delta = 0.0;
+
+	int _evaluate_level(Node *p_owner, Node *p_agent) const;
+	Node *_get_reference_node(Node *p_owner) const;
+
+public:
+	_FORCE_INLINE_ bool is_enabled() const { return level != 0 || level_callback.is_valid() || !distances.is_empty(); }
+
+	// Accumulates p_delta. Returns true if the owner should update in this frame,
+	// in which case r_delta is set to the time accumulated since its previous update.
+	bool advance(double p_delta, Node *p_owner, Node *p_agent, double &r_delta);
+	void reset();
+
+	void set_level(int p_level);
+	int get_level() const { return level; }
+
+	void set_level_callback(const Callable &p_callback) { level_callback = p_callback; }
+	Callable get_level_callback() const { return level_callback; }
+
+	void set_distances(const PackedFloat32Array &p_distances) { distances = p_distances; }
+	PackedFloat32Array get_distances() const { return distances; }
+
+	void set_reference_node(const NodePath &p_path) { reference_node = p_path; }
+	NodePath get_reference_node() const { return reference_node; }
+};
+
+#endif // LIMBO_TICK_LOD_H
@@ -0,0 +1,286 @@
+/**
+ * limbo_tick_server.cpp
+ * =============================================================================
+ * Copyright (c) 2023-present Serhii Snitsaruk and the LimboAI contributors.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#include "limbo_tick_server.h"
+
+#include "../compat/project_settings.h"
+#include "../compat/scene_tree.h"
+#include "limbo_string_names.h"
+
+#ifdef LIMBOAI_MODULE
+#include "core/object/worker_thread_pool.h"
+#include "core/os/time.h"
+#include "scene/main/window.h"
+#endif // LIMBOAI_MODULE
+
+#ifdef LIMBOAI_GDEXTENSION
+#include <godot_cpp/classes/time.hpp>
+#include <godot_cpp/classes/window.hpp>
+#include <godot_cpp/classes/worker_thread_pool.hpp>
+#endif // LIMBOAI_GDEXTENSION
+
+LimboTickServer *LimboTickServer::singleton = nullptr;
+
+LimboTickServer::LimboTickServer() {
+	singleton = this;
+	enabled = GLOBAL_DEF("limbo_ai/tick_server/enabled", false);
+	double budget_msec = GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "limbo_ai/tick_server/budget_msec", PROPERTY_HINT_RANGE, "0.1,100,0.1,or_greater,suffix:ms"), 2.0);
+	budget_usec = uint64_t(MAX(budget_msec, 0.0) * 1000.0);
+
+	PackedInt32Array default_intervals;
+	default_intervals.push_back(1);
+	default_intervals.push_back(4);
+	default_intervals.push_back(30);
+	PackedInt32Array intervals = GLOBAL_DEF("limbo_ai/tick_lod/intervals", default_intervals);
+	for (int i = 0; i < intervals.size(); i++) {
+		lod_intervals.push_back(MAX(1, intervals[i]));
+	}
+}
+
+LimboTickServer::~LimboTickServer() {
+	singleton = nullptr;
+}
+
+void LimboTickServer::initialize() {
+	memnew(LimboTickServer);
+}
+
+void LimboTickServer::deinitialize() {
+	if (singleton) {
+		memdelete(singleton);
+	}
+}
+
+void LimboTickServer::_connect_to_scene_tree() {
+	SceneTree *tree = SCENE_TREE();
+	ERR_FAIL_NULL(tree);
+	// * These signals are emitted before the scene tree processes its nodes.
+	tree->connect(LW_NAME(process_frame), callable_mp(this, &LimboTickServer::_on_process_frame));
+	tree->connect(LW_NAME(physics_frame), callable_mp(this, &LimboTickServer::_on_physics_frame));
+	connected = true;
+}
+
+double LimboTickServer::get_group_time(TickGroup p_group) {
+	ERR_FAIL_INDEX_V(p_group, TICK_MAX, 0.0);
+	// * Frames are only counted while connected, so start counting now.
+	if (unlikely(!connected)) {
+		_connect_to_scene_tree();
+	}
+	return p_group == TICK_PHYSICS ? physics_time : idle_time;
+}
+
+void LimboTickServer::register_node(Node *p_node, TickGroup p_group, TickCallback p_callback, const ThreadedCallbacks *p_threaded) {
+	ERR_FAIL_NULL(p_node);
+	ERR_FAIL_NULL(p_callback);
+	ERR_FAIL_INDEX(p_group, TICK_MAX);
+
+	if (p_group == TICK_BUDGETED) {
+		p_threaded = nullptr;
+	}
+
+	const Slot *slot = slots.getptr(p_node);
+	if (slot) {
+		if (slot->group == p_group) {
+			Entry &entry = groups[p_group].entries[slot->index];
+			entry.callback = p_callback;
+			entry.threaded = p_threaded;
+			return;
+		}
+		unregister_node(p_node);
+	}
+
+	if (unlikely(!connected)) {
+		_connect_to_scene_tree();
+	}
+
+	Group &group = groups[p_group];
+	Slot new_slot;
+	new_slot.group = p_group;
+	new_slot.index = group.entries.size();
+	Entry entry;
+	entry.node = p_node;
+	entry.callback = p_callback;
+	entry.threaded = p_threaded;
+	group.entries.push_back(entry);
+	slots.insert(p_node, new_slot);
+}
+
+void LimboTickServer::unregister_node(Node *p_node) {
+	const Slot *slot = slots.getptr(p_node);
+	if (!slot) {
+		return;
+	}
+	// * Leave a tombstone to keep the order and indices intact; removed in _compact().
+	Group &group = groups[slot->group];
+	group.entries[slot->index].node = nullptr;
+	group.num_removed += 1;
+	slots.erase(p_node);
+}
+
+void LimboTickServer::set_node_priority(Node *p_node, double p_priority) {
+	const Slot *slot = slots.getptr(p_node);
+	ERR_FAIL_NULL_MSG(slot, "LimboTickServer: Node is not registered.");
+	groups[slot->group].entries[slot->index].priority = MAX(p_priority, 0.0);
+}
+
+void LimboTickServer::_compact(TickGroup p_group) {
+	Group &group = groups[p_group];
+	uint32_t count = 0;
+	for (uint32_t i = 0; i < group.entries.size(); i++) {
+		if (group.entries[i].node == nullptr) {
+			continue;
+		}
+		if (i != count) {
+			group.entries[count] = group.entries[i];
+			slots[group.entries[count].node].index = count;
+		}
+		count += 1;
+	}
+	group.entries.resize(count);
+	group.num_removed = 0;
+}
+
+void LimboTickServer::_tick(TickGroup p_group, double p_delta) {
+	Group &group = groups[p_group];
+	ERR_FAIL_COND_MSG(group.ticking, "LimboTickServer: Recursive tick detected.");
+
+	if (group.num_removed > 0) {
+		_compact(p_group);
+	}
+
+	group.ticking = true;
+	// * Nodes registered during the tick are processed starting from the next frame.
+	const uint32_t count = group.entries.size();
+	_tick_threaded(group, count, p_delta);
+	for (uint32_t i = 0; i < count; i++) {
+		// * Copy: entries may be reallocated if a node is registered during the callback.
+		const Entry entry = group.entries[i];
+		if (entry.node && entry.threaded == nullptr && entry.node->can_process()) {
+			entry.callback(entry.node, p_delta);
+		}
+	}
+	group.ticking = false;
+}
+
+void LimboTickServer::_tick_threaded(Group &p_group, uint32_t p_count, double p_delta) {
+	threaded_batch.clear();
+	for (uint32_t i = 0; i < p_count; i++) {
+		const Entry entry = p_group.entries[i];
+		if (entry.node && entry.threaded && entry.node->can_process() && entry.threaded->prepare(entry.node, p_delta)) {
+			threaded_batch.push_back(entry);
+		}
+	}
+	if (threaded_batch.is_empty()) {
+		return;
+	}
+
+	run_parallel(&LimboTickServer::_run_threaded_entry, this, threaded_batch.size());
+
+	for (uint32_t i = 0; i < threaded_batch.size(); i++) {
+		const Entry &entry = threaded_batch[i];
+		// * Skip nodes removed by signal handlers of the previous ones.
+		if (slots.has(entry.node)) {
+			entry.threaded->finish(entry.node);
+		}
+	}
+	threaded_batch.clear();
+}
+
+void LimboTickServer::_run_threaded_entry(void *p_userdata, uint32_t p_index) {
+	const Entry &entry = static_cast<LimboTickServer *>(p_userdata)->threaded_batch[p_index];
+	entry.threaded->run(entry.node);
+}
+
+void LimboTickServer::run_parallel(ParallelFunc p_func, void *p_userdata, uint32_t p_count) {
+	ERR_FAIL_NULL(p_func);
+	if (p_count == 0) {
+		return;
+	}
+	if (p_count == 1 || parallel_func != nullptr) {
+		// * Not worth dispatching, or called from within a parallel batch.
+		for (uint32_t i = 0; i < p_count; i++) {
+			p_func(p_userdata, i);
+		}
+		return;
+	}
+
+	parallel_func = p_func;
+	parallel_userdata = p_userdata;
+	int64_t group_id = WorkerThreadPool::get_singleton()->add_group_task(
+			callable_mp(this, &LimboTickServer::_parallel_task), p_count, -1, true, "LimboAI: Parallel update");
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_id);
+	parallel_func = nullptr;
+	parallel_userdata = nullptr;
+}
+
+void LimboTickServer::_parallel_task(uint32_t p_index) {
+	parallel_func(parallel_userdata, p_index);
+}
+
+void LimboTickServer::_tick_budgeted(double p_delta) {
+	Group &group = groups[TICK_BUDGETED];
+	ERR_FAIL_COND_MSG(group.ticking, "LimboTickServer: Recursive tick detected.");
+
+	if (group.num_removed > 0) {
+		_compact(TICK_BUDGETED);
+	}
+	if (group.entries.is_empty()) {
+		return;
+	}
+
+	// * Accumulate time for all nodes that would be processed this frame, and rank them.
+	schedule.clear();
+	for (uint32_t i = 0; i < group.entries.size(); i++) {
+		Entry &entry = group.entries[i];
+		if (entry.node->can_process()) {
+			entry.pending_delta += p_delta;
+			ScheduledTick tick;
+			tick.score = entry.pending_delta * entry.priority;
+			tick.index = i;
+			schedule.push_back(tick);
+		}
+	}
+	schedule.sort();
+
+	group.ticking = true;
+	const uint64_t start = Time::get_singleton()->get_ticks_usec();
+	for (uint32_t i = 0; i < schedule.size(); i++) {
+		// * At least one node is ticked every frame, so that progress is guaranteed.
+		if (i > 0 && Time::get_singleton()->get_ticks_usec() - start >= budget_usec) {
+			break;
+		}
+		const uint32_t idx = schedule[i].index;
+		// * Copy: entries may be reallocated if a node is registered during the callback.
+		const Entry entry = group.entries[idx];
+		if (entry.node == nullptr) {
+			continue; // Unregistered during this tick.
+		}
+		group.entries[idx].pending_delta = 0.0;
+		entry.callback(entry.node, entry.pending_delta);
+	}
+	group.ticking = false;
+}
+
+void LimboTickServer::_on_process_frame() {
+	const double delta = SCENE_TREE()->get_root()->get_process_delta_time();
+	idle_time += delta;
+	_tick(TICK_IDLE, delta);
+	_tick_budgeted(delta);
+}
+
+void LimboTickServer::_on_physics_frame() {
+	const double delta = SCENE_TREE()->get_root()->get_physics_process_delta_time();
+	physics_time += delta;
+	_tick(TICK_PHYSICS, delta);
+}
+
+void LimboTickServer::_bind_methods() {
+}
@@ -0,0 +1,160 @@
+/**
+ * limbo_tick_server.h
+ * =============================================================================
+ * Copyright (c) 2023-present Serhii Snitsaruk and the LimboAI contributors.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#ifndef LIMBO_TICK_SERVER_H
+#define LIMBO_TICK_SERVER_H
+
+#ifdef LIMBOAI_MODULE
+#include "core/object/class_db.h"
+#include "core/object/object.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "scene/main/node.h"
+#endif // LIMBOAI_MODULE
+
+#ifdef LIMBOAI_GDEXTENSION
+#include <godot_cpp/classes/node.hpp>
+#include <godot_cpp/classes/object.hpp>
+#include <godot_cpp/templates/hash_map.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
+using namespace godot;
+#endif // LIMBOAI_GDEXTENSION
+
+// Drives BTPlayer and LimboHSM nodes from a single SceneTree callback per frame,
+// instead of one process notification per node. Enabled with the
+// "limbo_ai/tick_server/enabled" project setting.
+// Nodes are ticked in registration order, before regular node processing.
+// Nodes in the budgeted group share a per-frame time budget: the most overdue ones
+// (weighted by priority) are ticked first, each with the delta accumulated since its last tick.
+class LimboTickServer : public Object {
+	GDCLASS(LimboTickServer, Object);
+
+public:
+	enum TickGroup : unsigned int {
+		TICK_IDLE,
+		TICK_PHYSICS,
+		TICK_BUDGETED,
+		TICK_MAX,
+	};
+
+	typedef void (*TickCallback)(Node *p_node, double p_delta);
+
+	// Optional callbacks for nodes that can do the bulk of their update on worker threads.
+	// Such nodes are ticked before the rest of their group: prepare() is called on the main
+	// thread for each of them, then run() in parallel for those that returned true, and
+	// finally finish() on the main thread, in registration order.
+	struct ThreadedCallbacks {
+		bool (*prepare)(Node *p_node, double p_delta) = nullptr;
+		void (*run)(Node *p_node) = nullptr;
+		void (*finish)(Node *p_node) = nullptr;
+	};
+
+	typedef void (*ParallelFunc)(void *p_userdata, uint32_t p_index);
+
+private:
+	static LimboTickServer *singleton;
+
+	struct Entry {
+		Node *node = nullptr; // nullptr if unregistered (compacted after the tick).
+		TickCallback callback = nullptr;
+		const ThreadedCallbacks *threaded = nullptr; // Idle and physics groups only.
+		double priority = 1.0; // Budgeted group only.
+		double pending_delta = 0.0; // Budgeted group only.
+	};
+
+	struct ScheduledTick {
+		double score = 0.0;
+		uint32_t index = 0;
+
+		// Highest score first; ties are broken by registration order.
+		_FORCE_INLINE_ bool operator<(const ScheduledTick &p_other) const {
+			return score > p_other.score || (score == p_other.score && index < p_other.index);
+		}
+	};
+
+	struct Slot {
+		TickGroup group = TICK_IDLE;
+		uint32_t index = 0;
+	};
+
+	struct Group {
+		LocalVector<Entry> entries;
+		uint32_t num_removed = 0;
+		bool ticking = false;
+	};
+
+	bool enabled = false;
+	bool connected = false;
+	double idle_time = 0.0; // Sum of idle frame deltas since connecting to the scene tree.
+	double physics_time = 0.0; // Sum of physics frame deltas since connecting to the scene tree.
+	uint64_t budget_usec = 2000;
+	LocalVector<int> lod_intervals;
+	Group groups[TICK_MAX];
+	HashMap<Node *, Slot> slots;
+	LocalVector<ScheduledTick> schedule;
+	LocalVector<Entry> threaded_batch;
+
+	ParallelFunc parallel_func = nullptr;
+	void *parallel_userdata = nullptr;
+
+	void _connect_to_scene_tree();
+	void _compact(TickGroup p_group);
+	void _tick(TickGroup p_group, double p_delta);
+	void _tick_budgeted(double p_delta);
+	void _tick_threaded(Group &p_group, uint32_t p_count, double p_delta);
+	void _parallel_task(uint32_t p_index);
+	static void _run_threaded_entry(void *p_userdata, uint32_t p_index);
+
+	void _on_process_frame();
+	void _on_physics_frame();
+
+	LimboTickServer();
+
+protected:
+	static void _bind_methods();
+
+public:
+	static void initialize();
+	static void deinitialize();
+	_FORCE_INLINE_ static LimboTickServer *get_singleton() { return singleton; }
+
+	// Returns true if nodes should register with the tick server instead of using process notifications.
+	_FORCE_INLINE_ static bool is_enabled() { return singleton && singleton->enabled; }
+
+	void register_node(Node *p_node, TickGroup p_group, TickCallback p_callback, const ThreadedCallbacks *p_threaded = nullptr);
+	void unregister_node(Node *p_node);
+	_FORCE_INLINE_ bool is_node_registered(Node *p_node) const { return slots.has(p_node); }
+
+	// Priority of a node in the budgeted group. Higher priority nodes are ticked sooner.
+	void set_node_priority(Node *p_node, double p_priority);
+
+	int get_node_count() const { return slots.size(); }
+
+	// Sum of the deltas the given group has received so far; budgeted nodes share the idle frames.
+	// The difference between two readings is the time a node would have been passed in between.
+	double get_group_time(TickGroup p_group);
+
+	// Calls p_func for each index in [0, p_count) on the WorkerThreadPool, and waits for all of them to finish.
+	void run_parallel(ParallelFunc p_func, void *p_userdata, uint32_t p_count);
+
+	// Update interval in frames for the given tick LOD level (see LimboTickLOD).
+	// Levels beyond the configured ones use the last interval.
+	_FORCE_INLINE_ int get_lod_interval(int p_level) const {
+		if (lod_intervals.is_empty()) {
+			return 1;
+		}
+		return lod_intervals[CLAMP(p_level, 0, (int)lod_intervals.size() - 1)];
+	}
+
+	~LimboTickServer();
+};
+
+#endif // LIMBO_TICK_SERVER_H
@@ -172,6 +172,20 @@ String LimboUtility::get_check_operator_string(CheckType p_check_type) const {
 }
 
 bool LimboUtility::perform_check(CheckType p_check_type, const Variant &left_value, const Variant &right_value) {
+	// * Fast path for numbers and booleans, which make up the bulk of checks.
+	// * Follows Variant operator semantics: ints compare exactly, mixed int/float compare as floats.
+	const Variant::Type left_type = left_value.get_type();
+	const Variant::Type right_type = right_value.get_type();
+	if (left_type == Variant::INT && right_type == Variant::INT) {
+		return compare<int64_t>(p_check_type, left_value, right_value);
+	}
+	if ((left_type == Variant::FLOAT || left_type == Variant::INT) && (right_type == Variant::FLOAT || right_type == Variant::INT)) {
+		return compare<double>(p_check_type, left_value, right_value);
+	}
+	if (left_type == Variant::BOOL && right_type == Variant::BOOL) {
+		return compare<bool>(p_check_type, left_value, right_value);
+	}
+
 	Variant ret;
 	switch (p_check_type) {
 		case LimboUtility::CheckType::CHECK_EQUAL: {
@@ -80,7 +80,47 @@ public:
 	String get_check_operator_string(CheckType p_check_type) const;
 	bool perform_check(CheckType p_check_type, const Variant &left_value, const Variant &right_value);
 
+	// Typed counterpart of perform_check() for native code that already holds unboxed values.
+	template <typename T>
+	static _FORCE_INLINE_ bool compare(CheckType p_check_type, const T &p_left, const T &p_right) {
+		switch (p_check_type) {
+			case CHECK_EQUAL:
+				return p_left == p_right;
+			case CHECK_LESS_THAN:
+				return p_left < p_right;
+			case CHECK_LESS_THAN_OR_EQUAL:
+				return p_left <= p_right;
+			case CHECK_GREATER_THAN:
+				return p_left > p_right;
+			case CHECK_GREATER_THAN_OR_EQUAL:
+				return p_left >= p_right;
+			case CHECK_NOT_EQUAL:
+				return p_left != p_right;
+			default:
+				return false;
+		}
+	}
+
 	String get_operation_string(Operation p_operation) const;
+
+	// Typed counterpart of perform_operation() for the operations that work alike on numbers and vectors.
+	// Returns false for the other operations, which are left to perform_operation().
+	template <typename T>
+	static _FORCE_INLINE_ bool operate(Operation p_operation, const T &p_left, const T &p_right, T &r_result) {
+		switch (p_operation) {
+			case OPERATION_ADDITION:
+				r_result = p_left + p_right;
+				return true;
+			case OPERATION_SUBTRACTION:
+				r_result = p_left - p_right;
+				return true;
+			case OPERATION_MULTIPLICATION:
+				r_result = p_left * p_right;
+				return true;
+			default:
+				return false;
+		}
+	}
 	Variant perform_operation(Operation p_operation, const Variant &left_value, const Variant &right_value);
 
 	String get_property_hint_text(PropertyHint p_hint) const;